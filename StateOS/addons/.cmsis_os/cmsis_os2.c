@@ -79,6 +79,32 @@ osStatus_t osKernelGetInfo (osVersion_t *version, char *id_buf, uint32_t id_size
 	return osOK;
 }
 
+osStatus_t osKernelGetHeapInfo (osHeapInfo_t *info)
+{
+	hsi_t heap;
+
+	if (IS_IRQ_MODE() || IS_IRQ_MASKED())
+		return osErrorISR;
+
+	if (info == NULL)
+		return osErrorParameter;
+
+	sys_heapWalk();
+	sys_heapInfo(&heap);
+
+	info->size     = (uint32_t)heap.size;
+	info->free     = (uint32_t)heap.free;
+	info->max_used = (uint32_t)heap.max_used;
+	info->blocks   = (uint32_t)heap.blocks;
+	info->largest  = (uint32_t)heap.largest;
+	info->frag     = (uint32_t)heap.frag;
+	info->allocs   = (uint32_t)heap.allocs;
+	info->frees    = (uint32_t)heap.frees;
+	info->failures = (uint32_t)heap.failures;
+
+	return osOK;
+}
+
 osKernelState_t osKernelGetState (void)
 {
 	return osKernelRunning;
@@ -252,7 +278,7 @@ osThreadId_t osThreadNew (osThreadFunc_t func, void *argument, const osThreadAtt
 		if (attr->cb_mem    == NULL || attr->cb_size    == 0U) thread->tsk.hdr.obj.res = thread;
 		else
 		if (attr->stack_mem == NULL || attr->stack_size == 0U) thread->tsk.hdr.obj.res = stack_mem;
-		thread->tsk.join = (flags & osThreadJoinable) ? JOINABLE : DETACHED;
+		thread->tsk.join.queue = (flags & osThreadJoinable) ? JOINABLE : DETACHED;
 		flg_init(&thread->flg, 0);
 		thread->flags = flags;
 		thread->name = (attr == NULL) ? NULL : attr->name;
@@ -446,12 +472,38 @@ uint32_t osThreadGetStackSpace (osThreadId_t thread_id)
 	if (&thread->tsk == &MAIN)
 		return 0U;
 
+#if OS_STACK_SCAN
+	return (uint32_t) thread->tsk.size - tsk_stackUsed(&thread->tsk);
+#else
 	if (&thread->tsk != tsk_this())
 		return (uint32_t) thread->tsk.sp - (uint32_t) thread->tsk.stack;
 
 	return (uint32_t) port_get_sp() - (uint32_t) thread->tsk.stack;
+#endif
 }
 
+#if OS_TASK_STATS
+
+osStatus_t osThreadGetInfo (osThreadId_t thread_id, osThreadInfo_t *info)
+{
+	osThread_t *thread = thread_id;
+	tst_t stats;
+
+	if ((thread_id == NULL) || (info == NULL))
+		return osErrorParameter;
+
+	tsk_stats(&thread->tsk, &stats);
+
+	info->run_time = stats.time;
+	info->max_run  = stats.max;
+	info->switches = (uint32_t)stats.switches;
+	info->preempts = (uint32_t)stats.preempts;
+
+	return osOK;
+}
+
+#endif
+
 uint32_t osThreadGetCount (void)
 {
 	tsk_t   *tsk;
@@ -468,7 +520,7 @@ uint32_t osThreadGetCount (void)
 		for (tsk = IDLE.hdr.next; tsk != &IDLE; tsk = tsk->hdr.next)
 			count++;
 
-		for (tmr = WAIT.hdr.next; tmr != &WAIT; tmr = tmr->hdr.next)
+		for (tmr = core_tmr_next(&WAIT); tmr != &WAIT; tmr = core_tmr_next(tmr))
 			if (tmr->hdr.id == ID_READY)
 				count++;
 	}
@@ -493,7 +545,7 @@ uint32_t osThreadEnumerate (osThreadId_t *thread_array, uint32_t array_items)
 		for (tsk = IDLE.hdr.next; (tsk != &IDLE) && (count < array_items); tsk = tsk->hdr.next)
 			thread_array[count++] = tsk;
 
-		for (tmr = WAIT.hdr.next; (tmr != &WAIT) && (count < array_items); tmr = tmr->hdr.next)
+		for (tmr = core_tmr_next(&WAIT); (tmr != &WAIT) && (count < array_items); tmr = core_tmr_next(tmr))
 			if (tmr->hdr.id == ID_READY)
 				thread_array[count++] = tmr;
 	}
@@ -48,6 +48,44 @@ extern "C" {
 
 /*---------------------------------------------------------------------------*/
 
+/// Heap Information (StateOS extension)
+typedef struct {
+  uint32_t                       size;   ///< size of the system heap (0 => heap provided by the compiler libraries)
+  uint32_t                       free;   ///< number of free bytes
+  uint32_t                   max_used;   ///< high-water mark of the used bytes
+  uint32_t                     blocks;   ///< number of free memory blocks
+  uint32_t                    largest;   ///< size of the largest free memory block
+  uint32_t                       frag;   ///< fragmentation index in percent
+  uint32_t                     allocs;   ///< number of successful allocations
+  uint32_t                      frees;   ///< number of releases
+  uint32_t                   failures;   ///< number of failed allocations
+} osHeapInfo_t;
+
+/// Get Heap Information (StateOS extension).
+/// \param[out]    info          pointer to buffer for retrieving heap information.
+/// \return status code that indicates the execution status of the function.
+osStatus_t osKernelGetHeapInfo (osHeapInfo_t *info);
+
+#if OS_TASK_STATS
+
+/// Thread Information (StateOS extension).
+typedef struct {
+  uint64_t                   run_time;   ///< total run time (in cycles of frequency CYC_FREQUENCY)
+  uint64_t                    max_run;   ///< longest single run (in cycles of frequency CYC_FREQUENCY)
+  uint32_t                   switches;   ///< number of switches to the thread
+  uint32_t                   preempts;   ///< number of switches from the thread while it was still ready
+} osThreadInfo_t;
+
+/// Get Thread Information (StateOS extension).
+/// \param[in]     thread_id     thread ID obtained by \ref osThreadNew or \ref osThreadGetId.
+/// \param[out]    info          pointer to buffer for retrieving thread information.
+/// \return status code that indicates the execution status of the function.
+osStatus_t osThreadGetInfo (osThreadId_t thread_id, osThreadInfo_t *info);
+
+#endif
+
+/*---------------------------------------------------------------------------*/
+
 #define IS_IRQ_MODE()    port_isr_context()
 #define IS_IRQ_MASKED()  port_isr_masked()
 
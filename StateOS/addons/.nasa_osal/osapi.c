@@ -1362,8 +1362,24 @@ int32 OS_ShMemGetIdByName(uint32 *ShMemId, const char *SegName)
 
 int32 OS_HeapGetInfo(OS_heap_prop_t *heap_prop)
 {
-	(void) heap_prop;
+	hsi_t info;
+
+	if (heap_prop == NULL)
+		return OS_INVALID_POINTER;
+
+#if OS_HEAP_SIZE
+	sys_heapWalk();
+	sys_heapInfo(&info);
+
+	heap_prop->free_bytes         = (uint32)info.free;
+	heap_prop->free_blocks        = (uint32)info.blocks;
+	heap_prop->largest_free_block = (uint32)info.largest;
+
+	return OS_SUCCESS;
+#else
+	(void) info;
 	return OS_ERR_NOT_IMPLEMENTED;
+#endif
 }
 
 /* -------------------------------------------------------------------------- */
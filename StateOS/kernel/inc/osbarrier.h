@@ -71,6 +71,28 @@ extern "C" {
 
 #define               _BAR_INIT( _limit ) { _OBJ_INIT(), _limit }
 
+/******************************************************************************
+ *
+ * Name              : _BAR_INIT_BKT
+ *
+ * Description       : create and initialize a barrier object
+ *
+ * Parameters
+ *   limit           : number of tasks that must call bar_wait[Until|For] function to release the barrier object
+ *   bkt             : pointer to buckets of the BLOCKED queue (see _BKT_INIT)
+ *                     NULL: BLOCKED queue sorted by priority
+ *
+ * Return            : barrier object
+ *
+ * Note              : for internal use
+ *                     available only when OS_QUEUE_BUCKETS > 0
+ *
+ ******************************************************************************/
+
+#if OS_QUEUE_BUCKETS
+#define               _BAR_INIT_BKT( _limit, _bkt ) { _OBJ_INIT_BKT(_bkt), _limit }
+#endif
+
 /******************************************************************************
  *
  * Name              : OS_BAR
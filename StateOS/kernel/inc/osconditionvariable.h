@@ -74,6 +74,27 @@ extern "C" {
 
 #define               _CND_INIT() { _OBJ_INIT() }
 
+/******************************************************************************
+ *
+ * Name              : _CND_INIT_BKT
+ *
+ * Description       : create and initialize a condition variable object
+ *
+ * Parameters
+ *   bkt             : pointer to buckets of the BLOCKED queue (see _BKT_INIT)
+ *                     NULL: BLOCKED queue sorted by priority
+ *
+ * Return            : condition variable object
+ *
+ * Note              : for internal use
+ *                     available only when OS_QUEUE_BUCKETS > 0
+ *
+ ******************************************************************************/
+
+#if OS_QUEUE_BUCKETS
+#define               _CND_INIT_BKT( _bkt ) { _OBJ_INIT_BKT(_bkt) }
+#endif
+
 /******************************************************************************
  *
  * Name              : OS_CND
@@ -364,6 +385,27 @@ void cnd_notifyOne( cnd_t *cnd ) { cnd_give(cnd, false); }
 __STATIC_INLINE
 void cnd_notifyAll( cnd_t *cnd ) { cnd_give(cnd, true); }
 
+/******************************************************************************
+ *
+ * Name              : cnd_stats
+ *
+ * Description       : get statistics of the condition variable object
+ *
+ * Parameters
+ *   cnd             : pointer to condition variable object
+ *   stats           : pointer to the object statistics structure
+ *
+ * Return            : none
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     available only when OS_OBJECT_STATS > 0
+ *
+ ******************************************************************************/
+
+#if OS_OBJECT_STATS
+void cnd_stats( cnd_t *cnd, ost_t *stats );
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -408,6 +450,9 @@ struct ConditionVariable : public __cnd
 	void     giveISR  ( bool   _all = cndAll )      {        cnd_giveISR  (this, _all);         }
 	void     notifyOne( void )                      {        cnd_notifyOne(this);               }
 	void     notifyAll( void )                      {        cnd_notifyAll(this);               }
+#if OS_OBJECT_STATS
+	void     stats    ( ost_t *_stats )             {        cnd_stats    (this, _stats);       }
+#endif
 };
 
 #endif//__cplusplus
@@ -0,0 +1,315 @@
+/******************************************************************************
+
+    @file    StateOS: oscoroutine.h
+    @author  Rajmund Szymanski
+    @date    17.10.2026
+    @brief   This file contains definitions for StateOS.
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+#ifndef __STATEOS_COR_H
+#define __STATEOS_COR_H
+
+#include "oskernel.h"
+#include "osalloc.h"
+#include "oscriticalsection.h"
+#include "osevent.h"
+#include "osflag.h"
+#include "ossemaphore.h"
+#include "osstreambuffer.h"
+#include "osmessagebuffer.h"
+#include "osmailboxqueue.h"
+#include "oseventqueue.h"
+#include "ostimer.h"
+#include "ostask.h"
+
+/* -------------------------------------------------------------------------- */
+
+#if defined(__cplusplus) && defined(__cpp_impl_coroutine) && OS_TASK_PROXY
+
+#include <coroutine>
+
+struct CoScheduler;
+
+/******************************************************************************
+ *
+ * Class             : CoTask
+ *
+ * Description       : coroutine executed by the coroutine scheduler (CoScheduler)
+ *                     the coroutine is suspended at the start and executed after it has been spawned by the scheduler,
+ *                     the frame of the coroutine is allocated on the system heap and released when the coroutine returns
+ *
+ * Note              : coroutine is the function returning CoTask
+ *                     CoTask is empty (false) if the frame of the coroutine could not be allocated
+ *
+ ******************************************************************************/
+
+struct CoTask
+{
+	struct promise_type
+	{
+		CoScheduler  * sch  = nullptr; // scheduler of the coroutine
+		promise_type * next = nullptr; // next coroutine in the READY list of the scheduler
+
+		static
+		void *operator new   ( size_t _size ) noexcept { return sys_alloc(_size); }
+		static
+		void  operator delete( void *_ptr )            {        sys_free(_ptr); }
+
+		static
+		CoTask              get_return_object_on_allocation_failure( void ) noexcept { return CoTask(nullptr); }
+		CoTask              get_return_object  ( void )          { return CoTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+		std::suspend_always initial_suspend    ( void ) noexcept { return {}; }
+		std::suspend_always final_suspend      ( void ) noexcept { return {}; }
+		void                return_void        ( void )          {}
+		void                unhandled_exception( void )          { assert(!"unhandled exception"); }
+	};
+
+	typedef std::coroutine_handle<promise_type> handle;
+
+	 CoTask( CoTask &&_co ): h(_co.h) { _co.h = nullptr; }
+	~CoTask( void ) { if (h) h.destroy(); }
+
+	CoTask( const CoTask & ) = delete;
+	CoTask &operator=( const CoTask & ) = delete;
+
+	explicit
+	operator bool( void ) const { return h != nullptr; }
+
+	private:
+	explicit CoTask( handle _h ): h(_h) {}
+	handle h;
+
+	friend struct CoScheduler;
+};
+
+/******************************************************************************
+ *
+ * Class             : CoScheduler
+ *
+ * Description       : scheduler of coroutines, multiplexes coroutines on one task
+ *                     coroutine waiting for the kernel object is represented in the BLOCKED queue of the object by the proxy task,
+ *                     the wakeup handler of the proxy task puts the coroutine into the READY list of the scheduler
+ *
+ * Note              : 'run' must be executed by the scheduler task (e.g. as the task state)
+ *                     coroutines must not call the blocking functions directly (only with co_await ThisCoroutine::xxx)
+ *
+ ******************************************************************************/
+
+struct CoScheduler
+{
+	 CoScheduler( void ): sem_(0, semBinary) {}
+	~CoScheduler( void ) { assert(head_ == nullptr); }
+
+	CoScheduler( const CoScheduler & ) = delete;
+	CoScheduler &operator=( const CoScheduler & ) = delete;
+
+	// add the coroutine to the READY list of the scheduler
+	// return E_SUCCESS or E_FAILURE if the frame of the coroutine could not be allocated
+	unsigned spawn( CoTask &&_co )
+	{
+		CoTask::promise_type *co;
+
+		if (!_co)
+			return E_FAILURE;
+
+		co = &_co.h.promise();
+		_co.h = nullptr;
+		co->sch = this;
+		ready(co);
+
+		return E_SUCCESS;
+	}
+
+	// wait for the ready coroutines and execute them until they are suspended or finished
+	void run( void )
+	{
+		CoTask::promise_type *co;
+
+		sem_.wait();
+		while (co = pop(), co != nullptr)
+		{
+			CoTask::handle h = CoTask::handle::from_promise(*co);
+			h.resume();
+			if (h.done())
+				h.destroy();
+		}
+	}
+
+	// put the coroutine into the READY list; may be used both in thread and handler mode
+	void ready( CoTask::promise_type *_co )
+	{
+		sys_lock();
+		{
+			_co->next = nullptr;
+			*tail_ = _co;
+			tail_ = &_co->next;
+			sem_give(&sem_);
+		}
+		sys_unlock();
+	}
+
+	private:
+	CoTask::promise_type *pop( void )
+	{
+		CoTask::promise_type *co;
+
+		sys_lock();
+		{
+			co = head_;
+			if (co != nullptr && (head_ = co->next) == nullptr)
+				tail_ = &head_;
+		}
+		sys_unlock();
+
+		return co;
+	}
+
+	Semaphore              sem_;            // wakeup of the scheduler task
+	CoTask::promise_type * head_ = nullptr; // READY list of coroutines
+	CoTask::promise_type **tail_ = &head_;
+};
+
+/******************************************************************************
+ *
+ * Class             : CoWaiter<>
+ *
+ * Description       : awaitable blocking wait of the coroutine
+ *                     the blocking function 'fun' is called by the scheduler task with the wait delegated to the proxy task,
+ *                     the coroutine is suspended until the wait is over
+ *
+ * Constructor parameters
+ *   fun             : blocking function (returns the result of the wait)
+ *
+ * Note              : for internal use
+ *
+ ******************************************************************************/
+
+template<class F>
+struct CoWaiter
+{
+	explicit
+	 CoWaiter( F _fun ): fun(_fun) {}
+	~CoWaiter( void ) { if (pxy.guard != nullptr) tsk_reset(&pxy); } // the coroutine has been destroyed while waiting
+
+	bool await_ready( void ) { return false; }
+
+	bool await_suspend( CoTask::handle _h )
+	{
+		co = &_h.promise();
+		sys_lock();
+		{
+			tsk_proxy(&pxy, wakeup);
+			event = fun();
+			pending = pxy.guard != nullptr;
+			tsk_proxy(nullptr, nullptr);
+		}
+		sys_unlock();
+		return pending;
+	}
+
+	unsigned await_resume( void ) { return pending ? pxy.event : event; }
+
+	private:
+	static
+	void wakeup( tsk_t *_pxy ) { CoWaiter *w = reinterpret_cast<CoWaiter *>(_pxy); w->co->sch->ready(w->co); }
+
+	tsk_t                  pxy {};          // proxy of the scheduler task; must be the first field
+	F                      fun;
+	CoTask::promise_type * co = nullptr;
+	unsigned               event = E_TIMEOUT;
+	bool                   pending = false;
+};
+
+/******************************************************************************
+ *
+ * Namespace         : ThisCoroutine
+ *
+ * Description       : provide set of awaitable blocking functions for current coroutine (co_await ThisCoroutine::xxx)
+ *                     functions have the same parameters and results as the corresponding blocking functions of the kernel objects
+ *                     buffers passed to the functions must be valid until the wait is over (e.g. local variables of the coroutine)
+ *                     there are no sleepNext / waitNext functions: the start time of the periodic wait would be shared
+ *                     by all coroutines of the scheduler, use sleepUntil / waitUntil with the time kept by the coroutine instead
+ *
+ ******************************************************************************/
+
+namespace ThisCoroutine
+{
+	static inline auto sleepFor  ( cnt_t _delay )                                               { return CoWaiter([=]{ tsk_sleepFor  (_delay); return E_TIMEOUT; }); }
+	static inline auto sleepUntil( cnt_t _time )                                                { return CoWaiter([=]{ tsk_sleepUntil(_time);  return E_TIMEOUT; }); }
+
+	static inline auto waitFor   ( sem_t *_sem, cnt_t _delay )                                  { return CoWaiter([=]{ return sem_waitFor  (_sem, _delay); }); }
+	static inline auto waitUntil ( sem_t *_sem, cnt_t _time )                                   { return CoWaiter([=]{ return sem_waitUntil(_sem, _time); }); }
+	static inline auto wait      ( sem_t *_sem )                                                { return waitFor(_sem, INFINITE); }
+	static inline auto sendFor   ( sem_t *_sem, cnt_t _delay )                                  { return CoWaiter([=]{ return sem_sendFor  (_sem, _delay); }); }
+	static inline auto sendUntil ( sem_t *_sem, cnt_t _time )                                   { return CoWaiter([=]{ return sem_sendUntil(_sem, _time); }); }
+	static inline auto send      ( sem_t *_sem )                                                { return sendFor(_sem, INFINITE); }
+
+	static inline auto waitFor   ( evt_t *_evt, unsigned *_data, cnt_t _delay )                 { return CoWaiter([=]{ return evt_waitFor  (_evt, _data, _delay); }); }
+	static inline auto waitUntil ( evt_t *_evt, unsigned *_data, cnt_t _time )                  { return CoWaiter([=]{ return evt_waitUntil(_evt, _data, _time); }); }
+	static inline auto wait      ( evt_t *_evt, unsigned *_data )                               { return waitFor(_evt, _data, INFINITE); }
+
+	static inline auto waitFor   ( flg_t *_flg, unsigned _flags, char _mode, cnt_t _delay )     { return CoWaiter([=]{ return flg_waitFor  (_flg, _flags, _mode, _delay); }); }
+	static inline auto waitUntil ( flg_t *_flg, unsigned _flags, char _mode, cnt_t _time )      { return CoWaiter([=]{ return flg_waitUntil(_flg, _flags, _mode, _time); }); }
+	static inline auto wait      ( flg_t *_flg, unsigned _flags, char _mode )                   { return waitFor(_flg, _flags, _mode, INFINITE); }
+
+	static inline auto waitFor   ( tmr_t *_tmr, cnt_t _delay )                                  { return CoWaiter([=]{ return tmr_waitFor  (_tmr, _delay); }); }
+	static inline auto waitUntil ( tmr_t *_tmr, cnt_t _time )                                   { return CoWaiter([=]{ return tmr_waitUntil(_tmr, _time); }); }
+	static inline auto wait      ( tmr_t *_tmr )                                                { return waitFor(_tmr, INFINITE); }
+
+	static inline auto waitFor   ( box_t *_box, void *_data, cnt_t _delay )                     { return CoWaiter([=]{ return box_waitFor  (_box, _data, _delay); }); }
+	static inline auto waitUntil ( box_t *_box, void *_data, cnt_t _time )                      { return CoWaiter([=]{ return box_waitUntil(_box, _data, _time); }); }
+	static inline auto wait      ( box_t *_box, void *_data )                                   { return waitFor(_box, _data, INFINITE); }
+	static inline auto sendFor   ( box_t *_box, const void *_data, cnt_t _delay )               { return CoWaiter([=]{ return box_sendFor  (_box, _data, _delay); }); }
+	static inline auto sendUntil ( box_t *_box, const void *_data, cnt_t _time )                { return CoWaiter([=]{ return box_sendUntil(_box, _data, _time); }); }
+	static inline auto send      ( box_t *_box, const void *_data )                             { return sendFor(_box, _data, INFINITE); }
+
+	static inline auto waitFor   ( evq_t *_evq, unsigned *_data, cnt_t _delay )                 { return CoWaiter([=]{ return evq_waitFor  (_evq, _data, _delay); }); }
+	static inline auto waitUntil ( evq_t *_evq, unsigned *_data, cnt_t _time )                  { return CoWaiter([=]{ return evq_waitUntil(_evq, _data, _time); }); }
+	static inline auto wait      ( evq_t *_evq, unsigned *_data )                               { return waitFor(_evq, _data, INFINITE); }
+	static inline auto sendFor   ( evq_t *_evq, unsigned _data, cnt_t _delay )                  { return CoWaiter([=]{ return evq_sendFor  (_evq, _data, _delay); }); }
+	static inline auto sendUntil ( evq_t *_evq, unsigned _data, cnt_t _time )                   { return CoWaiter([=]{ return evq_sendUntil(_evq, _data, _time); }); }
+	static inline auto send      ( evq_t *_evq, unsigned _data )                                { return sendFor(_evq, _data, INFINITE); }
+
+	static inline auto waitFor   ( msg_t *_msg, void *_data, unsigned _size, cnt_t _delay )     { return CoWaiter([=]{ return msg_waitFor  (_msg, _data, _size, _delay); }); }
+	static inline auto waitUntil ( msg_t *_msg, void *_data, unsigned _size, cnt_t _time )      { return CoWaiter([=]{ return msg_waitUntil(_msg, _data, _size, _time); }); }
+	static inline auto wait      ( msg_t *_msg, void *_data, unsigned _size )                   { return waitFor(_msg, _data, _size, INFINITE); }
+	static inline auto sendFor   ( msg_t *_msg, const void *_data, unsigned _size, cnt_t _delay ) { return CoWaiter([=]{ return msg_sendFor  (_msg, _data, _size, _delay); }); }
+	static inline auto sendUntil ( msg_t *_msg, const void *_data, unsigned _size, cnt_t _time )  { return CoWaiter([=]{ return msg_sendUntil(_msg, _data, _size, _time); }); }
+	static inline auto send      ( msg_t *_msg, const void *_data, unsigned _size )             { return sendFor(_msg, _data, _size, INFINITE); }
+
+	static inline auto waitFor   ( stm_t *_stm, void *_data, unsigned _size, cnt_t _delay )     { return CoWaiter([=]{ return stm_waitFor  (_stm, _data, _size, _delay); }); }
+	static inline auto waitUntil ( stm_t *_stm, void *_data, unsigned _size, cnt_t _time )      { return CoWaiter([=]{ return stm_waitUntil(_stm, _data, _size, _time); }); }
+	static inline auto wait      ( stm_t *_stm, void *_data, unsigned _size )                   { return waitFor(_stm, _data, _size, INFINITE); }
+	static inline auto sendFor   ( stm_t *_stm, const void *_data, unsigned _size, cnt_t _delay ) { return CoWaiter([=]{ return stm_sendFor  (_stm, _data, _size, _delay); }); }
+	static inline auto sendUntil ( stm_t *_stm, const void *_data, unsigned _size, cnt_t _time )  { return CoWaiter([=]{ return stm_sendUntil(_stm, _data, _size, _time); }); }
+	static inline auto send      ( stm_t *_stm, const void *_data, unsigned _size )             { return sendFor(_stm, _data, _size, INFINITE); }
+}
+
+#endif//__cplusplus && __cpp_impl_coroutine && OS_TASK_PROXY
+
+/* -------------------------------------------------------------------------- */
+
+#endif//__STATEOS_COR_H
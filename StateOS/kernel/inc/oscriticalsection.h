@@ -58,6 +58,10 @@ lck_t core_set_lock( void )
 	lck_t prv = port_get_lock();
 	port_set_lock();
 	__COMPILER_BARRIER();
+#if OS_LOCK_PROFILE
+	if (prv != port_get_lock())
+		core_cri_enter();
+#endif
 	return prv;
 }
 
@@ -79,6 +83,7 @@ __STATIC_INLINE
 lck_t core_clr_lock( void )
 {
 	lck_t prv = port_get_lock();
+	core_cri_leave();
 	port_clr_lock();
 	__COMPILER_BARRIER();
 	return prv;
@@ -103,6 +108,10 @@ __STATIC_INLINE
 void core_put_lock( lck_t lck )
 {
 	__COMPILER_BARRIER();
+#if OS_LOCK_PROFILE
+	if (lck != port_get_lock())
+		core_cri_leave();
+#endif
 	port_put_lock(lck);
 }
 
@@ -170,6 +179,71 @@ lck_t core_get_lock( void )
 #define                sys_unlockISR() \
                        sys_unlock()
 
+/******************************************************************************
+ *
+ * Name              : critical section statistics
+ *
+ ******************************************************************************/
+
+#define CRI_BUCKETS  32 // number of the histogram buckets
+
+typedef struct __cri cri_t;
+
+struct __cri
+{
+	const
+	void   * site;  // call site (return address inside the function that entered the critical section)
+	                // NULL => call site is unknown or the call site table is full
+	unsigned count; // number of the critical sections
+	cyc_t    max;   // the longest critical section (in cycles, frequency CYC_FREQUENCY)
+	uint64_t time;  // total time of the critical sections (in cycles)
+	unsigned hist[CRI_BUCKETS]; // histogram: hist[n] => duration in range [2^n, 2^(n+1)) cycles, hist[0] includes 0
+};
+
+/******************************************************************************
+ *
+ * Name              : cri_stats
+ *
+ * Description       : get the statistics of the critical sections, sorted from the longest one
+ *                     only the outermost interrupt-masked regions are measured,
+ *                     nested regions are accounted to the call site that entered the outermost one
+ *
+ * Parameters
+ *   data            : pointer to the buffer of statistics
+ *   count           : size of the buffer (in records)
+ *
+ * Return            : number of records stored in the buffer
+ *
+ * Note              : use addr2line or the map file to find the function of the call site
+ *                     may be used both in thread and handler mode
+ *                     available only when OS_LOCK_PROFILE > 0
+ *
+ ******************************************************************************/
+
+#if OS_LOCK_PROFILE
+unsigned cri_stats( cri_t *data, unsigned count );
+#endif
+
+/******************************************************************************
+ *
+ * Name              : cri_reset
+ *
+ * Description       : clear the statistics of the critical sections
+ *                     the statistics are cleared in one critical section, so it is recorded as a long one
+ *
+ * Parameters        : none
+ *
+ * Return            : none
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     available only when OS_LOCK_PROFILE > 0
+ *
+ ******************************************************************************/
+
+#if OS_LOCK_PROFILE
+void cri_reset( void );
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -67,6 +67,27 @@ extern "C" {
 
 #define               _EVT_INIT() { _OBJ_INIT() }
 
+/******************************************************************************
+ *
+ * Name              : _EVT_INIT_BKT
+ *
+ * Description       : create and initialize an event object
+ *
+ * Parameters
+ *   bkt             : pointer to buckets of the BLOCKED queue (see _BKT_INIT)
+ *                     NULL: BLOCKED queue sorted by priority
+ *
+ * Return            : event object
+ *
+ * Note              : for internal use
+ *                     available only when OS_QUEUE_BUCKETS > 0
+ *
+ ******************************************************************************/
+
+#if OS_QUEUE_BUCKETS
+#define               _EVT_INIT_BKT( _bkt ) { _OBJ_INIT_BKT(_bkt) }
+#endif
+
 /******************************************************************************
  *
  * Name              : OS_EVT
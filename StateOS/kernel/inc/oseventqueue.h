@@ -52,6 +52,9 @@ struct __evq
 	unsigned head;  // first element to read from data buffer
 	unsigned tail;  // first element to write into data buffer
 	unsigned*data;  // data buffer
+#if OS_RING_POW2
+	unsigned mask;  // mask of the ring buffer (see _RNG_MASK)
+#endif
 };
 
 #ifdef __cplusplus
@@ -81,7 +84,30 @@ extern "C" {
  *
  ******************************************************************************/
 
-#define               _EVQ_INIT( _limit, _data ) { _OBJ_INIT(), 0, _limit, 0, 0, _data }
+#define               _EVQ_INIT( _limit, _data ) { _OBJ_INIT(), 0, _limit, 0, 0, _data _RNG_INIT(_limit) }
+
+/******************************************************************************
+ *
+ * Name              : _EVQ_INIT_BKT
+ *
+ * Description       : create and initialize an event queue object
+ *
+ * Parameters
+ *   limit           : size of a queue (max number of stored events)
+ *   data            : event queue data buffer
+ *   bkt             : pointer to buckets of the BLOCKED queue (see _BKT_INIT)
+ *                     NULL: BLOCKED queue sorted by priority
+ *
+ * Return            : event queue object
+ *
+ * Note              : for internal use
+ *                     available only when OS_QUEUE_BUCKETS > 0
+ *
+ ******************************************************************************/
+
+#if OS_QUEUE_BUCKETS
+#define               _EVQ_INIT_BKT( _limit, _data, _bkt ) { _OBJ_INIT_BKT(_bkt), 0, _limit, 0, 0, _data _RNG_INIT(_limit) }
+#endif
 
 /******************************************************************************
  *
@@ -485,6 +511,27 @@ void evq_push( evq_t *evq, unsigned data );
 __STATIC_INLINE
 void evq_pushISR( evq_t *evq, unsigned data ) { evq_push(evq, data); }
 
+/******************************************************************************
+ *
+ * Name              : evq_stats
+ *
+ * Description       : get statistics of the event queue object
+ *
+ * Parameters
+ *   evq             : pointer to event queue object
+ *   stats           : pointer to the object statistics structure
+ *
+ * Return            : none
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     available only when OS_OBJECT_STATS > 0
+ *
+ ******************************************************************************/
+
+#if OS_OBJECT_STATS
+void evq_stats( evq_t *evq, ost_t *stats );
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -545,6 +592,9 @@ struct EventQueueT : public __evq
 	unsigned spaceISR ( void )                         { return evq_spaceISR (this);                }
 	unsigned limit    ( void )                         { return evq_limit    (this);                }
 	unsigned limitISR ( void )                         { return evq_limitISR (this);                }
+#if OS_OBJECT_STATS
+	void     stats    ( ost_t *_stats )                {        evq_stats    (this, _stats);        }
+#endif
 
 	private:
 	unsigned data_[limit_];
@@ -71,6 +71,27 @@ extern "C" {
 
 #define               _MUT_INIT() { _OBJ_INIT(), NULL }
 
+/******************************************************************************
+ *
+ * Name              : _MUT_INIT_BKT
+ *
+ * Description       : create and initialize a fast mutex object
+ *
+ * Parameters
+ *   bkt             : pointer to buckets of the BLOCKED queue (see _BKT_INIT)
+ *                     NULL: BLOCKED queue sorted by priority
+ *
+ * Return            : fast mutex object
+ *
+ * Note              : for internal use
+ *                     available only when OS_QUEUE_BUCKETS > 0
+ *
+ ******************************************************************************/
+
+#if OS_QUEUE_BUCKETS
+#define               _MUT_INIT_BKT( _bkt ) { _OBJ_INIT_BKT(_bkt), NULL }
+#endif
+
 /******************************************************************************
  *
  * Name              : OS_MUT
@@ -348,6 +369,27 @@ unsigned mut_give( mut_t *mut );
 __STATIC_INLINE
 unsigned mut_unlock( mut_t *mut ) { return mut_give(mut); }
 
+/******************************************************************************
+ *
+ * Name              : mut_stats
+ *
+ * Description       : get statistics of the fast mutex object
+ *
+ * Parameters
+ *   mut             : pointer to fast mutex object
+ *   stats           : pointer to the object statistics structure
+ *
+ * Return            : none
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     available only when OS_OBJECT_STATS > 0
+ *
+ ******************************************************************************/
+
+#if OS_OBJECT_STATS
+void mut_stats( mut_t *mut, ost_t *stats );
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -390,6 +432,9 @@ struct FastMutex : public __mut
 	unsigned lock     ( void )         { return mut_lock     (this);         }
 	unsigned give     ( void )         { return mut_give     (this);         }
 	unsigned unlock   ( void )         { return mut_unlock   (this);         }
+#if OS_OBJECT_STATS
+	void     stats    ( ost_t *_stats ) {       mut_stats    (this, _stats); }
+#endif
 };
 
 #endif//__cplusplus
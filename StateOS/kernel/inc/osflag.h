@@ -83,6 +83,28 @@ extern "C" {
 
 #define               _FLG_INIT( _init ) { _OBJ_INIT(), _init }
 
+/******************************************************************************
+ *
+ * Name              : _FLG_INIT_BKT
+ *
+ * Description       : create and initialize a flag object
+ *
+ * Parameters
+ *   init            : initial value of flag
+ *   bkt             : pointer to buckets of the BLOCKED queue (see _BKT_INIT)
+ *                     NULL: BLOCKED queue sorted by priority
+ *
+ * Return            : flag object
+ *
+ * Note              : for internal use
+ *                     available only when OS_QUEUE_BUCKETS > 0
+ *
+ ******************************************************************************/
+
+#if OS_QUEUE_BUCKETS
+#define               _FLG_INIT_BKT( _init, _bkt ) { _OBJ_INIT_BKT(_bkt), _init }
+#endif
+
 /******************************************************************************
  *
  * Name              : _VA_FLG
@@ -442,6 +464,27 @@ unsigned flg_get( flg_t *flg );
 __STATIC_INLINE
 unsigned flg_getISR( flg_t *flg ) { return flg_get(flg); }
 
+/******************************************************************************
+ *
+ * Name              : flg_stats
+ *
+ * Description       : get statistics of the flag object
+ *
+ * Parameters
+ *   flg             : pointer to flag object
+ *   stats           : pointer to the object statistics structure
+ *
+ * Return            : none
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     available only when OS_OBJECT_STATS > 0
+ *
+ ******************************************************************************/
+
+#if OS_OBJECT_STATS
+void flg_stats( flg_t *flg, ost_t *stats );
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -489,6 +532,9 @@ struct Flag : public __flg
 	unsigned clearISR ( unsigned _flags )                           { return flg_clearISR (this, _flags);                }
 	unsigned get      ( void )                                      { return flg_get      (this);                        }
 	unsigned getISR   ( void )                                      { return flg_getISR   (this);                        }
+#if OS_OBJECT_STATS
+	void     stats    ( ost_t *_stats )                             {        flg_stats    (this, _stats);                }
+#endif
 };
 
 #endif//__cplusplus
@@ -53,6 +53,9 @@ struct __job
 	unsigned head;  // first element to read from data buffer
 	unsigned tail;  // first element to write into data buffer
 	fun_t ** data;  // data buffer
+#if OS_RING_POW2
+	unsigned mask;  // mask of the ring buffer (see _RNG_MASK)
+#endif
 };
 
 #ifdef __cplusplus
@@ -82,7 +85,30 @@ extern "C" {
  *
  ******************************************************************************/
 
-#define               _JOB_INIT( _limit, _data ) { _OBJ_INIT(), 0, _limit, 0, 0, _data }
+#define               _JOB_INIT( _limit, _data ) { _OBJ_INIT(), 0, _limit, 0, 0, _data _RNG_INIT(_limit) }
+
+/******************************************************************************
+ *
+ * Name              : _JOB_INIT_BKT
+ *
+ * Description       : create and initialize a job queue object
+ *
+ * Parameters
+ *   limit           : size of a queue (max number of stored job procedures)
+ *   data            : job queue data buffer
+ *   bkt             : pointer to buckets of the BLOCKED queue (see _BKT_INIT)
+ *                     NULL: BLOCKED queue sorted by priority
+ *
+ * Return            : job queue object
+ *
+ * Note              : for internal use
+ *                     available only when OS_QUEUE_BUCKETS > 0
+ *
+ ******************************************************************************/
+
+#if OS_QUEUE_BUCKETS
+#define               _JOB_INIT_BKT( _limit, _data, _bkt ) { _OBJ_INIT_BKT(_bkt), 0, _limit, 0, 0, _data _RNG_INIT(_limit) }
+#endif
 
 /******************************************************************************
  *
@@ -482,6 +508,27 @@ void job_push( job_t *job, fun_t *fun );
 __STATIC_INLINE
 void job_pushISR( job_t *job, fun_t *fun ) { job_push(job, fun); }
 
+/******************************************************************************
+ *
+ * Name              : job_stats
+ *
+ * Description       : get statistics of the job queue object
+ *
+ * Parameters
+ *   job             : pointer to job queue object
+ *   stats           : pointer to the object statistics structure
+ *
+ * Return            : none
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     available only when OS_OBJECT_STATS > 0
+ *
+ ******************************************************************************/
+
+#if OS_OBJECT_STATS
+void job_stats( job_t *job, ost_t *stats );
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -538,6 +585,9 @@ struct JobQueueT : public __box
 	unsigned spaceISR ( void )                     {             unsigned space = box_spaceISR (this);                                                return space; }
 	unsigned limit    ( void )                     {             unsigned limit = box_limit    (this);                                                return limit; }
 	unsigned limitISR ( void )                     {             unsigned limit = box_limitISR (this);                                                return limit; }
+#if OS_OBJECT_STATS
+	void     stats    ( ost_t *_stats )            {                              box_stats    (this, _stats);                                                      }
+#endif
 
 	private:
 	FUN_t data_[limit_];
@@ -580,6 +630,9 @@ struct JobQueueT : public __job
 	unsigned spaceISR ( void )                     { return job_spaceISR (this);               }
 	unsigned limit    ( void )                     { return job_limit    (this);               }
 	unsigned limitISR ( void )                     { return job_limitISR (this);               }
+#if OS_OBJECT_STATS
+	void     stats    ( ost_t *_stats )            {        job_stats    (this, _stats);       }
+#endif
 
 	private:
 	FUN_t data_[limit_];
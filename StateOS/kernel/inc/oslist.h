@@ -98,6 +98,27 @@ struct __lst
 
 #define               _LST_INIT() { _OBJ_INIT(), _QUE_INIT() }
 
+/******************************************************************************
+ *
+ * Name              : _LST_INIT_BKT
+ *
+ * Description       : create and initialize a list object
+ *
+ * Parameters
+ *   bkt             : pointer to buckets of the BLOCKED queue (see _BKT_INIT)
+ *                     NULL: BLOCKED queue sorted by priority
+ *
+ * Return            : list object
+ *
+ * Note              : for internal use
+ *                     available only when OS_QUEUE_BUCKETS > 0
+ *
+ ******************************************************************************/
+
+#if OS_QUEUE_BUCKETS
+#define               _LST_INIT_BKT( _bkt ) { _OBJ_INIT_BKT(_bkt), _QUE_INIT() }
+#endif
+
 /******************************************************************************
  *
  * Name              : OS_LST
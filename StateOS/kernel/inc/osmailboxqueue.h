@@ -53,6 +53,9 @@ struct __box
 	unsigned head;  // first element to read from data buffer
 	unsigned tail;  // first element to write into data buffer
 	char   * data;  // data buffer
+#if OS_RING_POW2
+	unsigned mask;  // mask of the ring buffer (see _RNG_MASK)
+#endif
 };
 
 #ifdef __cplusplus
@@ -83,7 +86,31 @@ extern "C" {
  *
  ******************************************************************************/
 
-#define               _BOX_INIT( _limit, _size, _data ) { _OBJ_INIT(), 0, _limit * _size, _size, 0, 0, _data }
+#define               _BOX_INIT( _limit, _size, _data ) { _OBJ_INIT(), 0, _limit * _size, _size, 0, 0, _data _RNG_INIT(_limit * _size) }
+
+/******************************************************************************
+ *
+ * Name              : _BOX_INIT_BKT
+ *
+ * Description       : create and initialize a mailbox queue object
+ *
+ * Parameters
+ *   limit           : size of a queue (max number of stored mails)
+ *   size            : size of a single mail (in bytes)
+ *   data            : mailbox queue data buffer
+ *   bkt             : pointer to buckets of the BLOCKED queue (see _BKT_INIT)
+ *                     NULL: BLOCKED queue sorted by priority
+ *
+ * Return            : mailbox queue object
+ *
+ * Note              : for internal use
+ *                     available only when OS_QUEUE_BUCKETS > 0
+ *
+ ******************************************************************************/
+
+#if OS_QUEUE_BUCKETS
+#define               _BOX_INIT_BKT( _limit, _size, _data, _bkt ) { _OBJ_INIT_BKT(_bkt), 0, _limit * _size, _size, 0, 0, _data _RNG_INIT(_limit * _size) }
+#endif
 
 /******************************************************************************
  *
@@ -532,6 +559,27 @@ unsigned box_space( box_t *box );
 __STATIC_INLINE
 unsigned box_spaceISR( box_t *box ) { return box_space(box); }
 
+/******************************************************************************
+ *
+ * Name              : box_stats
+ *
+ * Description       : get statistics of the mailbox queue object
+ *
+ * Parameters
+ *   box             : pointer to mailbox queue object
+ *   stats           : pointer to the object statistics structure
+ *
+ * Return            : none
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     available only when OS_OBJECT_STATS > 0
+ *
+ ******************************************************************************/
+
+#if OS_OBJECT_STATS
+void box_stats( box_t *box, ost_t *stats );
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -587,6 +635,9 @@ struct MailBoxQueueT : public __box
 	unsigned spaceISR ( void )                            { return box_spaceISR (this);                }
 	unsigned limit    ( void )                            { return box_limit    (this);                }
 	unsigned limitISR ( void )                            { return box_limitISR (this);                }
+#if OS_OBJECT_STATS
+	void     stats    ( ost_t *_stats )                   {        box_stats    (this, _stats);        }
+#endif
 
 	private:
 	char data_[limit_ * size_];
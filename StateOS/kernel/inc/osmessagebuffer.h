@@ -52,6 +52,9 @@ struct __msg
 	unsigned head;  // inherited from stream buffer
 	unsigned tail;  // inherited from stream buffer
 	char   * data;  // inherited from stream buffer
+#if OS_RING_POW2
+	unsigned mask;  // mask of the ring buffer (see _RNG_MASK)
+#endif
 };
 
 #ifdef __cplusplus
@@ -81,7 +84,30 @@ extern "C" {
  *
  ******************************************************************************/
 
-#define               _MSG_INIT( _limit, _data ) { _OBJ_INIT(), 0, _limit, 0, 0, _data }
+#define               _MSG_INIT( _limit, _data ) { _OBJ_INIT(), 0, _limit, 0, 0, _data _RNG_INIT(_limit) }
+
+/******************************************************************************
+ *
+ * Name              : _MSG_INIT_BKT
+ *
+ * Description       : create and initialize a message buffer object
+ *
+ * Parameters
+ *   limit           : size of a buffer (max number of stored bytes)
+ *   data            : message buffer data
+ *   bkt             : pointer to buckets of the BLOCKED queue (see _BKT_INIT)
+ *                     NULL: BLOCKED queue sorted by priority
+ *
+ * Return            : message buffer object
+ *
+ * Note              : for internal use
+ *                     available only when OS_QUEUE_BUCKETS > 0
+ *
+ ******************************************************************************/
+
+#if OS_QUEUE_BUCKETS
+#define               _MSG_INIT_BKT( _limit, _data, _bkt ) { _OBJ_INIT_BKT(_bkt), 0, _limit, 0, 0, _data _RNG_INIT(_limit) }
+#endif
 
 /******************************************************************************
  *
@@ -516,6 +542,111 @@ unsigned msg_push( msg_t *msg, const void *data, unsigned size );
 __STATIC_INLINE
 unsigned msg_pushISR( msg_t *msg, const void *data, unsigned size ) { return msg_push(msg, data, size); }
 
+/******************************************************************************
+ *
+ * Name              : msg_reserve
+ * ISR alias         : msg_reserveISR
+ *
+ * Description       : try to reserve space for the message in the message buffer object,
+ *                     the message can be written directly into the returned span and then committed with msg_commit
+ *
+ * Parameters
+ *   msg             : pointer to message buffer object
+ *   rng             : pointer to the span of the reserved space
+ *   size            : size of the reserved space
+ *
+ * Return
+ *   E_SUCCESS       : space for the message was successfully reserved
+ *   E_TIMEOUT       : not enough space in the message buffer
+ *   E_FAILURE       : size of the message is out of the limit
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     reserve / commit and peekSpan / release pairs must not be interleaved
+ *                     with other writes / reads of the message buffer respectively (single producer / single consumer)
+ *
+ ******************************************************************************/
+
+unsigned msg_reserve( msg_t *msg, rng_t *rng, unsigned size );
+
+__STATIC_INLINE
+unsigned msg_reserveISR( msg_t *msg, rng_t *rng, unsigned size ) { return msg_reserve(msg, rng, size); }
+
+/******************************************************************************
+ *
+ * Name              : msg_commit
+ * ISR alias         : msg_commitISR
+ *
+ * Description       : commit the message written into the span returned by msg_reserve,
+ *                     wake up the tasks waiting for the message
+ *
+ * Parameters
+ *   msg             : pointer to message buffer object
+ *   size            : size of the written message (not greater than the size of the reservation)
+ *
+ * Return            : none
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     reserve / commit and peekSpan / release pairs must not be interleaved
+ *                     with other writes / reads of the message buffer respectively (single producer / single consumer)
+ *
+ ******************************************************************************/
+
+void msg_commit( msg_t *msg, unsigned size );
+
+__STATIC_INLINE
+void msg_commitISR( msg_t *msg, unsigned size ) { msg_commit(msg, size); }
+
+/******************************************************************************
+ *
+ * Name              : msg_peekSpan
+ * ISR alias         : msg_peekSpanISR
+ *
+ * Description       : get the span of the first message contained in the message buffer object,
+ *                     the message can be read directly from the returned span and then released with msg_release
+ *
+ * Parameters
+ *   msg             : pointer to message buffer object
+ *   rng             : pointer to the span of the data
+ *
+ * Return
+ *   'another'       : size of the message
+ *   E_TIMEOUT       : message buffer object is empty
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     reserve / commit and peekSpan / release pairs must not be interleaved
+ *                     with other writes / reads of the message buffer respectively (single producer / single consumer)
+ *
+ ******************************************************************************/
+
+unsigned msg_peekSpan( msg_t *msg, rng_t *rng );
+
+__STATIC_INLINE
+unsigned msg_peekSpanISR( msg_t *msg, rng_t *rng ) { return msg_peekSpan(msg, rng); }
+
+/******************************************************************************
+ *
+ * Name              : msg_release
+ * ISR alias         : msg_releaseISR
+ *
+ * Description       : remove the message read from the span returned by msg_peekSpan from the message buffer object,
+ *                     transfer the messages of the tasks waiting for free space
+ *
+ * Parameters
+ *   msg             : pointer to message buffer object
+ *
+ * Return            : none
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     reserve / commit and peekSpan / release pairs must not be interleaved
+ *                     with other writes / reads of the message buffer respectively (single producer / single consumer)
+ *
+ ******************************************************************************/
+
+void msg_release( msg_t *msg );
+
+__STATIC_INLINE
+void msg_releaseISR( msg_t *msg ) { msg_release(msg); }
+
 /******************************************************************************
  *
  * Name              : msg_count
@@ -600,6 +731,27 @@ unsigned msg_size( msg_t *msg );
 __STATIC_INLINE
 unsigned msg_sizeISR( msg_t *msg ) { return msg_size(msg); }
 
+/******************************************************************************
+ *
+ * Name              : msg_stats
+ *
+ * Description       : get statistics of the message buffer object
+ *
+ * Parameters
+ *   msg             : pointer to message buffer object
+ *   stats           : pointer to the object statistics structure
+ *
+ * Return            : none
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     available only when OS_OBJECT_STATS > 0
+ *
+ ******************************************************************************/
+
+#if OS_OBJECT_STATS
+void msg_stats( msg_t *msg, ost_t *stats );
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -648,6 +800,10 @@ struct MessageBufferT : public __msg
 	unsigned send     ( const void *_data, unsigned _size )               { return msg_send     (this, _data, _size);         }
 	unsigned push     ( const void *_data, unsigned _size )               { return msg_push     (this, _data, _size);         }
 	unsigned pushISR  ( const void *_data, unsigned _size )               { return msg_pushISR  (this, _data, _size);         }
+	unsigned reserve  ( rng_t *_rng, unsigned _size )                     { return msg_reserve  (this, _rng, _size);          }
+	void     commit   ( unsigned _size )                                  {        msg_commit   (this, _size);                }
+	unsigned peekSpan ( rng_t *_rng )                                     { return msg_peekSpan (this, _rng);                 }
+	void     release  ( void )                                            {        msg_release  (this);                       }
 	unsigned count    ( void )                                            { return msg_count    (this);                       }
 	unsigned countISR ( void )                                            { return msg_countISR (this);                       }
 	unsigned space    ( void )                                            { return msg_space    (this);                       }
@@ -656,6 +812,9 @@ struct MessageBufferT : public __msg
 	unsigned limitISR ( void )                                            { return msg_limitISR (this);                       }
 	unsigned size     ( void )                                            { return msg_size     (this);                       }
 	unsigned sizeISR  ( void )                                            { return msg_sizeISR  (this);                       }
+#if OS_OBJECT_STATS
+	void     stats    ( ost_t *_stats )                                   {        msg_stats    (this, _stats);               }
+#endif
 
 	private:
 	char data_[limit_];
@@ -105,6 +105,33 @@ extern "C" {
 
 #define               _MTX_INIT( _mode, _prio ) { _OBJ_INIT(), NULL, _mode, 0, _prio, NULL }
 
+/******************************************************************************
+ *
+ * Name              : _MTX_INIT_BKT
+ *
+ * Description       : create and initialize a mutex object
+ *
+ * Parameters
+ *   mode            : mutex mode (mutex type + mutex protocol + mutex robustness)
+ *                           type: mtxNormal or mtxErrorCheck or mtxRecursive
+ *                       protocol: mtxPrioNone or mtxPrioInherit or mtxPrioProtect
+ *                     robustness: mtxStalled or mtxRobust
+ *   prio            : mutex priority; unused if mtxPrioProtect protocol is not set
+ *   bkt             : pointer to buckets of the BLOCKED queue (see _BKT_INIT)
+ *                     NULL: BLOCKED queue sorted by priority
+ *
+ * Return            : mutex object
+ *
+ * Note              : for internal use
+ *                     priority inheritance takes the priority of the first task in the BLOCKED queue
+ *                     available only when OS_QUEUE_BUCKETS > 0
+ *
+ ******************************************************************************/
+
+#if OS_QUEUE_BUCKETS
+#define               _MTX_INIT_BKT( _mode, _prio, _bkt ) { _OBJ_INIT_BKT(_bkt), NULL, _mode, 0, _prio, NULL }
+#endif
+
 /******************************************************************************
  *
  * Name              : _VA_MTX
@@ -468,6 +495,27 @@ unsigned mtx_give( mtx_t *mtx );
 __STATIC_INLINE
 unsigned mtx_unlock( mtx_t *mtx ) { return mtx_give(mtx); }
 
+/******************************************************************************
+ *
+ * Name              : mtx_stats
+ *
+ * Description       : get statistics of the mutex object
+ *
+ * Parameters
+ *   mtx             : pointer to mutex object
+ *   stats           : pointer to the object statistics structure
+ *
+ * Return            : none
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     available only when OS_OBJECT_STATS > 0
+ *
+ ******************************************************************************/
+
+#if OS_OBJECT_STATS
+void mtx_stats( mtx_t *mtx, ost_t *stats );
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -518,6 +566,9 @@ struct Mutex : public __mtx
 	unsigned lock     ( void )            { return mtx_lock     (this);         }
 	unsigned give     ( void )            { return mtx_give     (this);         }
 	unsigned unlock   ( void )            { return mtx_unlock   (this);         }
+#if OS_OBJECT_STATS
+	void     stats    ( ost_t *_stats )   {        mtx_stats    (this, _stats); }
+#endif
 };
 
 #endif//__cplusplus
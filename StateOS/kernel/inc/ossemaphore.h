@@ -83,6 +83,32 @@ extern "C" {
 
 #define               _SEM_INIT( _init, _limit ) { _OBJ_INIT(), _init, _limit }
 
+/******************************************************************************
+ *
+ * Name              : _SEM_INIT_BKT
+ *
+ * Description       : create and initialize a semaphore object
+ *
+ * Parameters
+ *   init            : initial value of semaphore counter
+ *   limit           : maximum value of semaphore counter
+ *                     semBinary: binary semaphore
+ *                     semCounting: counting semaphore
+ *                     otherwise: limited semaphore
+ *   bkt             : pointer to buckets of the BLOCKED queue (see _BKT_INIT)
+ *                     NULL: BLOCKED queue sorted by priority
+ *
+ * Return            : semaphore object
+ *
+ * Note              : for internal use
+ *                     available only when OS_QUEUE_BUCKETS > 0
+ *
+ ******************************************************************************/
+
+#if OS_QUEUE_BUCKETS
+#define               _SEM_INIT_BKT( _init, _limit, _bkt ) { _OBJ_INIT_BKT(_bkt), _init, _limit }
+#endif
+
 /******************************************************************************
  *
  * Name              : _VA_SEM
@@ -491,6 +517,27 @@ unsigned sem_send( sem_t *sem ) { return sem_sendFor(sem, INFINITE); }
 
 unsigned sem_getValue( sem_t *sem );
 
+/******************************************************************************
+ *
+ * Name              : sem_stats
+ *
+ * Description       : get statistics of the semaphore object
+ *
+ * Parameters
+ *   sem             : pointer to semaphore object
+ *   stats           : pointer to the object statistics structure
+ *
+ * Return            : none
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     available only when OS_OBJECT_STATS > 0
+ *
+ ******************************************************************************/
+
+#if OS_OBJECT_STATS
+void sem_stats( sem_t *sem, ost_t *stats );
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -542,6 +589,9 @@ struct Semaphore : public __sem
 	unsigned sendUntil( cnt_t _time )  { return sem_sendUntil(this, _time);  }
 	unsigned send     ( void )         { return sem_send     (this);         }
 	unsigned getValue ( void )         { return sem_getValue (this);         }
+#if OS_OBJECT_STATS
+	void     stats    ( ost_t *_stats ) {       sem_stats    (this, _stats); }
+#endif
 };
 
 /******************************************************************************
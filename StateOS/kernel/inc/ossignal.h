@@ -79,6 +79,28 @@ extern "C" {
 
 #define               _SIG_INIT( _mask ) { _OBJ_INIT(), 0, _mask }
 
+/******************************************************************************
+ *
+ * Name              : _SIG_INIT_BKT
+ *
+ * Description       : create and initialize a signal object
+ *
+ * Parameters
+ *   mask            : protection mask of signal object
+ *   bkt             : pointer to buckets of the BLOCKED queue (see _BKT_INIT)
+ *                     NULL: BLOCKED queue sorted by priority
+ *
+ * Return            : signal object
+ *
+ * Note              : for internal use
+ *                     available only when OS_QUEUE_BUCKETS > 0
+ *
+ ******************************************************************************/
+
+#if OS_QUEUE_BUCKETS
+#define               _SIG_INIT_BKT( _mask, _bkt ) { _OBJ_INIT_BKT(_bkt), 0, _mask }
+#endif
+
 /******************************************************************************
  *
  * Name              : _VA_SIG
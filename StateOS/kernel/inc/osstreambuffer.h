@@ -52,6 +52,9 @@ struct __stm
 	unsigned head;  // first element to read from data buffer
 	unsigned tail;  // first element to write into data buffer
 	char   * data;  // data buffer
+#if OS_RING_POW2
+	unsigned mask;  // mask of the ring buffer (see _RNG_MASK)
+#endif
 };
 
 #ifdef __cplusplus
@@ -65,6 +68,10 @@ struct stm_T { stm_t stm; char buf[]; };
 extern "C" {
 #endif
 
+// transfer data to the stream buffer object without recording the request in the trace buffer and object statistics
+// used by the kernel trace (trc_drain); must be called with the kernel locked
+unsigned core_stm_give( stm_t *stm, const void *data, unsigned size );
+
 /******************************************************************************
  *
  * Name              : _STM_INIT
@@ -81,7 +88,30 @@ extern "C" {
  *
  ******************************************************************************/
 
-#define               _STM_INIT( _limit, _data ) { _OBJ_INIT(), 0, _limit, 0, 0, _data }
+#define               _STM_INIT( _limit, _data ) { _OBJ_INIT(), 0, _limit, 0, 0, _data _RNG_INIT(_limit) }
+
+/******************************************************************************
+ *
+ * Name              : _STM_INIT_BKT
+ *
+ * Description       : create and initialize a stream buffer object
+ *
+ * Parameters
+ *   limit           : size of a buffer (max number of stored bytes)
+ *   data            : stream buffer data
+ *   bkt             : pointer to buckets of the BLOCKED queue (see _BKT_INIT)
+ *                     NULL: BLOCKED queue sorted by priority
+ *
+ * Return            : stream buffer object
+ *
+ * Note              : for internal use
+ *                     available only when OS_QUEUE_BUCKETS > 0
+ *
+ ******************************************************************************/
+
+#if OS_QUEUE_BUCKETS
+#define               _STM_INIT_BKT( _limit, _data, _bkt ) { _OBJ_INIT_BKT(_bkt), 0, _limit, 0, 0, _data _RNG_INIT(_limit) }
+#endif
 
 /******************************************************************************
  *
@@ -380,6 +410,88 @@ unsigned stm_waitUntil( stm_t *stm, void *data, unsigned size, cnt_t time );
 __STATIC_INLINE
 unsigned stm_wait( stm_t *stm, void *data, unsigned size ) { return stm_waitFor(stm, data, size, INFINITE); }
 
+/******************************************************************************
+ *
+ * Name              : stm_waitMinFor
+ *
+ * Description       : try to transfer data from the stream buffer object,
+ *                     wait for given duration of time while the stream buffer object contains less than 'min' bytes
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   data            : pointer to write buffer
+ *   min             : trigger level (minimum number of bytes to read), 0 < min <= size, min <= limit
+ *   size            : size of write buffer
+ *   delay           : duration of time (maximum number of ticks to wait while the stream buffer object contains less than 'min' bytes)
+ *                     IMMEDIATE: don't wait if the stream buffer object contains less than 'min' bytes
+ *                     INFINITE:  wait indefinitely while the stream buffer object contains less than 'min' bytes
+ *
+ * Return            : number of bytes read from the stream buffer or
+ *   E_STOPPED       : stream buffer object was reseted before the specified timeout expired
+ *   E_DELETED       : stream buffer object was deleted before the specified timeout expired
+ *   E_TIMEOUT       : stream buffer object contains less than 'min' bytes and was not received enough data before the specified timeout expired,
+ *                     data already stored in the stream buffer object remain there
+ *
+ * Note              : use only in thread mode
+ *                     waiting readers are served in order, the first one holds back the next ones until its trigger level is reached
+ *                     waiting reader gets less than 'min' bytes when the stream buffer object is full or a writer needs the space
+ *
+ ******************************************************************************/
+
+unsigned stm_waitMinFor( stm_t *stm, void *data, unsigned min, unsigned size, cnt_t delay );
+
+/******************************************************************************
+ *
+ * Name              : stm_waitMinUntil
+ *
+ * Description       : try to transfer data from the stream buffer object,
+ *                     wait until given timepoint while the stream buffer object contains less than 'min' bytes
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   data            : pointer to write buffer
+ *   min             : trigger level (minimum number of bytes to read), 0 < min <= size, min <= limit
+ *   size            : size of write buffer
+ *   time            : timepoint value
+ *
+ * Return            : number of bytes read from the stream buffer or
+ *   E_STOPPED       : stream buffer object was reseted before the specified timeout expired
+ *   E_DELETED       : stream buffer object was deleted before the specified timeout expired
+ *   E_TIMEOUT       : stream buffer object contains less than 'min' bytes and was not received enough data before the specified timeout expired,
+ *                     data already stored in the stream buffer object remain there
+ *
+ * Note              : use only in thread mode
+ *                     waiting readers are served in order, the first one holds back the next ones until its trigger level is reached
+ *                     waiting reader gets less than 'min' bytes when the stream buffer object is full or a writer needs the space
+ *
+ ******************************************************************************/
+
+unsigned stm_waitMinUntil( stm_t *stm, void *data, unsigned min, unsigned size, cnt_t time );
+
+/******************************************************************************
+ *
+ * Name              : stm_waitMin
+ *
+ * Description       : try to transfer data from the stream buffer object,
+ *                     wait indefinitely while the stream buffer object contains less than 'min' bytes
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   data            : pointer to write buffer
+ *   min             : trigger level (minimum number of bytes to read), 0 < min <= size, min <= limit
+ *   size            : size of write buffer
+ *
+ * Return            : number of bytes read from the stream buffer or
+ *   E_STOPPED       : stream buffer object was reseted
+ *   E_DELETED       : stream buffer object was deleted
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+unsigned stm_waitMin( stm_t *stm, void *data, unsigned min, unsigned size ) { return stm_waitMinFor(stm, data, min, size, INFINITE); }
+
 /******************************************************************************
  *
  * Name              : stm_give
@@ -486,6 +598,89 @@ unsigned stm_sendUntil( stm_t *stm, const void *data, unsigned size, cnt_t time
 __STATIC_INLINE
 unsigned stm_send( stm_t *stm, const void *data, unsigned size ) { return stm_sendFor(stm, data, size, INFINITE); }
 
+/******************************************************************************
+ *
+ * Name              : stm_writeFor
+ *
+ * Description       : transfer as much data to the stream buffer object as fits,
+ *                     wait for given duration of time for the space for the rest of the data
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   data            : pointer to read buffer
+ *   size            : size of read buffer
+ *   delay           : duration of time (maximum number of ticks to wait for the transfer of the whole data)
+ *                     IMMEDIATE: don't wait, transfer only the data that fits
+ *                     INFINITE:  wait indefinitely until the whole data is transferred
+ *
+ * Return            : number of bytes written to the stream buffer (less than 'size' if the specified timeout expired) or
+ *   E_STOPPED       : stream buffer object was reseted before the specified timeout expired
+ *   E_DELETED       : stream buffer object was deleted before the specified timeout expired
+ *
+ * Note              : use only in thread mode
+ *                     the data is transferred in parts as the space in the stream buffer object becomes available,
+ *                     so the transfer is not atomic and the data may be larger than the stream buffer object
+ *                     if the stream buffer object is reseted or deleted during the wait, the part of the data already written
+ *                     is lost (the reset discards the content of the stream buffer) and its size is not returned
+ *
+ ******************************************************************************/
+
+unsigned stm_writeFor( stm_t *stm, const void *data, unsigned size, cnt_t delay );
+
+/******************************************************************************
+ *
+ * Name              : stm_writeUntil
+ *
+ * Description       : transfer as much data to the stream buffer object as fits,
+ *                     wait until given timepoint for the space for the rest of the data
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   data            : pointer to read buffer
+ *   size            : size of read buffer
+ *   time            : timepoint value
+ *
+ * Return            : number of bytes written to the stream buffer (less than 'size' if the specified timeout expired) or
+ *   E_STOPPED       : stream buffer object was reseted before the specified timeout expired
+ *   E_DELETED       : stream buffer object was deleted before the specified timeout expired
+ *
+ * Note              : use only in thread mode
+ *                     the data is transferred in parts as the space in the stream buffer object becomes available,
+ *                     so the transfer is not atomic and the data may be larger than the stream buffer object
+ *                     if the stream buffer object is reseted or deleted during the wait, the part of the data already written
+ *                     is lost (the reset discards the content of the stream buffer) and its size is not returned
+ *
+ ******************************************************************************/
+
+unsigned stm_writeUntil( stm_t *stm, const void *data, unsigned size, cnt_t time );
+
+/******************************************************************************
+ *
+ * Name              : stm_write
+ *
+ * Description       : transfer as much data to the stream buffer object as fits,
+ *                     wait indefinitely for the space for the rest of the data
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   data            : pointer to read buffer
+ *   size            : size of read buffer
+ *
+ * Return            : number of bytes written to the stream buffer ('size') or
+ *   E_STOPPED       : stream buffer object was reseted
+ *   E_DELETED       : stream buffer object was deleted
+ *
+ * Note              : use only in thread mode
+ *                     the data is transferred in parts as the space in the stream buffer object becomes available,
+ *                     so the transfer is not atomic and the data may be larger than the stream buffer object
+ *                     if the stream buffer object is reseted or deleted during the wait, the part of the data already written
+ *                     is lost (the reset discards the content of the stream buffer) and its size is not returned
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+unsigned stm_write( stm_t *stm, const void *data, unsigned size ) { return stm_writeFor(stm, data, size, INFINITE); }
+
 /******************************************************************************
  *
  * Name              : stm_push
@@ -512,6 +707,112 @@ unsigned stm_push( stm_t *stm, const void *data, unsigned size );
 __STATIC_INLINE
 unsigned stm_pushISR( stm_t *stm, const void *data, unsigned size ) { return stm_push(stm, data, size); }
 
+/******************************************************************************
+ *
+ * Name              : stm_reserve
+ * ISR alias         : stm_reserveISR
+ *
+ * Description       : try to reserve space for the stream data in the stream buffer object,
+ *                     the data can be written directly into the returned span and then committed with stm_commit
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   rng             : pointer to the span of the reserved space
+ *   size            : size of the reserved space
+ *
+ * Return
+ *   E_SUCCESS       : space for the stream data was successfully reserved
+ *   E_TIMEOUT       : not enough space in the stream buffer
+ *   E_FAILURE       : size of the stream data is out of the limit
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     reserve / commit and peekSpan / release pairs must not be interleaved
+ *                     with other writes / reads of the stream buffer respectively (single producer / single consumer)
+ *
+ ******************************************************************************/
+
+unsigned stm_reserve( stm_t *stm, rng_t *rng, unsigned size );
+
+__STATIC_INLINE
+unsigned stm_reserveISR( stm_t *stm, rng_t *rng, unsigned size ) { return stm_reserve(stm, rng, size); }
+
+/******************************************************************************
+ *
+ * Name              : stm_commit
+ * ISR alias         : stm_commitISR
+ *
+ * Description       : commit the stream data written into the span returned by stm_reserve,
+ *                     wake up the tasks waiting for the data
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   size            : size of the written stream data (not greater than the size of the reservation)
+ *
+ * Return            : none
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     reserve / commit and peekSpan / release pairs must not be interleaved
+ *                     with other writes / reads of the stream buffer respectively (single producer / single consumer)
+ *
+ ******************************************************************************/
+
+void stm_commit( stm_t *stm, unsigned size );
+
+__STATIC_INLINE
+void stm_commitISR( stm_t *stm, unsigned size ) { stm_commit(stm, size); }
+
+/******************************************************************************
+ *
+ * Name              : stm_peekSpan
+ * ISR alias         : stm_peekSpanISR
+ *
+ * Description       : get the span of all data contained in the stream buffer object,
+ *                     the data can be read directly from the returned span and then released with stm_release
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   rng             : pointer to the span of the data
+ *
+ * Return
+ *   'another'       : amount of data contained in the stream buffer
+ *   E_TIMEOUT       : stream buffer object is empty
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     reserve / commit and peekSpan / release pairs must not be interleaved
+ *                     with other writes / reads of the stream buffer respectively (single producer / single consumer)
+ *
+ ******************************************************************************/
+
+unsigned stm_peekSpan( stm_t *stm, rng_t *rng );
+
+__STATIC_INLINE
+unsigned stm_peekSpanISR( stm_t *stm, rng_t *rng ) { return stm_peekSpan(stm, rng); }
+
+/******************************************************************************
+ *
+ * Name              : stm_release
+ * ISR alias         : stm_releaseISR
+ *
+ * Description       : remove data read from the span returned by stm_peekSpan from the stream buffer object,
+ *                     transfer the data of the tasks waiting for free space
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   size            : size of the read stream data (not greater than the size of the span)
+ *
+ * Return            : none
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     reserve / commit and peekSpan / release pairs must not be interleaved
+ *                     with other writes / reads of the stream buffer respectively (single producer / single consumer)
+ *
+ ******************************************************************************/
+
+void stm_release( stm_t *stm, unsigned size );
+
+__STATIC_INLINE
+void stm_releaseISR( stm_t *stm, unsigned size ) { stm_release(stm, size); }
+
 /******************************************************************************
  *
  * Name              : stm_count
@@ -575,6 +876,27 @@ unsigned stm_limit( stm_t *stm );
 __STATIC_INLINE
 unsigned stm_limitISR( stm_t *stm ) { return stm_limit(stm); }
 
+/******************************************************************************
+ *
+ * Name              : stm_stats
+ *
+ * Description       : get statistics of the stream buffer object
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   stats           : pointer to the object statistics structure
+ *
+ * Return            : none
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     available only when OS_OBJECT_STATS > 0
+ *
+ ******************************************************************************/
+
+#if OS_OBJECT_STATS
+void stm_stats( stm_t *stm, ost_t *stats );
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -607,28 +929,41 @@ struct StreamBufferT : public __stm
 		return reinterpret_cast<StreamBufferT<limit_> *>(stm_create(limit_));
 	}
 
-	void     reset    ( void )                                            {        stm_reset    (this);                       }
-	void     kill     ( void )                                            {        stm_kill     (this);                       }
-	void     destroy  ( void )                                            {        stm_destroy  (this);                       }
-	unsigned take     (       void *_data, unsigned _size )               { return stm_take     (this, _data, _size);         }
-	unsigned tryWait  (       void *_data, unsigned _size )               { return stm_tryWait  (this, _data, _size);         }
-	unsigned takeISR  (       void *_data, unsigned _size )               { return stm_takeISR  (this, _data, _size);         }
-	unsigned waitFor  (       void *_data, unsigned _size, cnt_t _delay ) { return stm_waitFor  (this, _data, _size, _delay); }
-	unsigned waitUntil(       void *_data, unsigned _size, cnt_t _time )  { return stm_waitUntil(this, _data, _size, _time);  }
-	unsigned wait     (       void *_data, unsigned _size )               { return stm_wait     (this, _data, _size);         }
-	unsigned give     ( const void *_data, unsigned _size )               { return stm_give     (this, _data, _size);         }
-	unsigned giveISR  ( const void *_data, unsigned _size )               { return stm_giveISR  (this, _data, _size);         }
-	unsigned sendFor  ( const void *_data, unsigned _size, cnt_t _delay ) { return stm_sendFor  (this, _data, _size, _delay); }
-	unsigned sendUntil( const void *_data, unsigned _size, cnt_t _time )  { return stm_sendUntil(this, _data, _size, _time);  }
-	unsigned send     ( const void *_data, unsigned _size )               { return stm_send     (this, _data, _size);         }
-	unsigned push     ( const void *_data, unsigned _size )               { return stm_push     (this, _data, _size);         }
-	unsigned pushISR  ( const void *_data, unsigned _size )               { return stm_pushISR  (this, _data, _size);         }
-	unsigned count    ( void )                                            { return stm_count    (this);                       }
-	unsigned countISR ( void )                                            { return stm_countISR (this);                       }
-	unsigned space    ( void )                                            { return stm_space    (this);                       }
-	unsigned spaceISR ( void )                                            { return stm_spaceISR (this);                       }
-	unsigned limit    ( void )                                            { return stm_limit    (this);                       }
-	unsigned limitISR ( void )                                            { return stm_limitISR (this);                       }
+	void     reset       ( void )                                                           {        stm_reset       (this);                             }
+	void     kill        ( void )                                                           {        stm_kill        (this);                             }
+	void     destroy     ( void )                                                           {        stm_destroy     (this);                             }
+	unsigned take        (       void *_data, unsigned _size )                              { return stm_take        (this, _data, _size);               }
+	unsigned tryWait     (       void *_data, unsigned _size )                              { return stm_tryWait     (this, _data, _size);               }
+	unsigned takeISR     (       void *_data, unsigned _size )                              { return stm_takeISR     (this, _data, _size);               }
+	unsigned waitFor     (       void *_data, unsigned _size, cnt_t _delay )                { return stm_waitFor     (this, _data, _size, _delay);       }
+	unsigned waitUntil   (       void *_data, unsigned _size, cnt_t _time )                 { return stm_waitUntil   (this, _data, _size, _time);        }
+	unsigned wait        (       void *_data, unsigned _size )                              { return stm_wait        (this, _data, _size);               }
+	unsigned waitMinFor  (       void *_data, unsigned _min, unsigned _size, cnt_t _delay ) { return stm_waitMinFor  (this, _data, _min, _size, _delay); }
+	unsigned waitMinUntil(       void *_data, unsigned _min, unsigned _size, cnt_t _time )  { return stm_waitMinUntil(this, _data, _min, _size, _time);  }
+	unsigned waitMin     (       void *_data, unsigned _min, unsigned _size )               { return stm_waitMin     (this, _data, _min, _size);         }
+	unsigned give        ( const void *_data, unsigned _size )                              { return stm_give        (this, _data, _size);               }
+	unsigned giveISR     ( const void *_data, unsigned _size )                              { return stm_giveISR     (this, _data, _size);               }
+	unsigned sendFor     ( const void *_data, unsigned _size, cnt_t _delay )                { return stm_sendFor     (this, _data, _size, _delay);       }
+	unsigned sendUntil   ( const void *_data, unsigned _size, cnt_t _time )                 { return stm_sendUntil   (this, _data, _size, _time);        }
+	unsigned send        ( const void *_data, unsigned _size )                              { return stm_send        (this, _data, _size);               }
+	unsigned writeFor    ( const void *_data, unsigned _size, cnt_t _delay )                { return stm_writeFor    (this, _data, _size, _delay);       }
+	unsigned writeUntil  ( const void *_data, unsigned _size, cnt_t _time )                 { return stm_writeUntil  (this, _data, _size, _time);        }
+	unsigned write       ( const void *_data, unsigned _size )                              { return stm_write       (this, _data, _size);               }
+	unsigned push        ( const void *_data, unsigned _size )                              { return stm_push        (this, _data, _size);               }
+	unsigned pushISR     ( const void *_data, unsigned _size )                              { return stm_pushISR     (this, _data, _size);               }
+	unsigned reserve     ( rng_t *_rng, unsigned _size )                                    { return stm_reserve     (this, _rng, _size);                }
+	void     commit      ( unsigned _size )                                                 {        stm_commit      (this, _size);                      }
+	unsigned peekSpan    ( rng_t *_rng )                                                    { return stm_peekSpan    (this, _rng);                       }
+	void     release     ( unsigned _size )                                                 {        stm_release     (this, _size);                      }
+	unsigned count       ( void )                                                           { return stm_count       (this);                             }
+	unsigned countISR    ( void )                                                           { return stm_countISR    (this);                             }
+	unsigned space       ( void )                                                           { return stm_space       (this);                             }
+	unsigned spaceISR    ( void )                                                           { return stm_spaceISR    (this);                             }
+	unsigned limit       ( void )                                                           { return stm_limit       (this);                             }
+	unsigned limitISR    ( void )                                                           { return stm_limitISR    (this);                             }
+#if OS_OBJECT_STATS
+	void     stats       ( ost_t *_stats )                                                  {        stm_stats       (this, _stats);                     }
+#endif
 
 	private:
 	char data_[limit_];
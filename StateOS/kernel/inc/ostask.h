@@ -85,7 +85,7 @@ struct __tsk
 	unsigned basic; // basic priority
 	unsigned prio;  // current priority
 
-	tsk_t  * join;  // joinable state
+	blq_t    join;  // joinable state, queue of the task waiting for termination
 	tsk_t ** guard; // BLOCKED queue for the pending process
 
 	unsigned event; // wakeup event
@@ -144,6 +144,8 @@ struct __tsk
 	char   * in;
 	}        data;
 	unsigned size;
+	unsigned min;   // trigger level of the waiting reader, 0 for the waiting writer
+	bool     part;  // the waiting writer transfers its data in parts
 	}        stm;   // temporary data used by stream buffer object
 
 	struct {
@@ -180,10 +182,56 @@ struct __tsk
 	}        tmp;
 #if defined(__ARMCC_VERSION) && !defined(__MICROLIB)
 	char     libspace[96];
-	#define _TSK_EXTRA { 0 }
+	#define _TSK_EXTRA { 0 },
 #else
 	#define _TSK_EXTRA
 #endif
+#if OS_STACK_SCAN
+	struct {
+	tsk_t  * next;  // next task in the list of tasks with scanned stacks
+	unsigned free;  // number of stack words never used by the task (high-water mark)
+	unsigned pos;   // position of the incremental stack scan (in stack words)
+	}        stk;
+	#define _TSK_STK { NULL, 0, 0 },
+#else
+	#define _TSK_STK
+#endif
+#if OS_STACK_SHARED
+	struct {
+	bool     mode;  // run-to-completion task dispatched on the shared stack
+	bool     init;  // the task has no frame on the shared stack, its context is initialized at the dispatch
+	}        shr;
+	#define _TSK_SHR { false, false },
+#else
+	#define _TSK_SHR
+#endif
+#if OS_TASK_PROXY
+	struct {
+	tsk_t  * tsk;   // proxy task making the next blocking wait of the task
+	void  (* fun)( tsk_t * ); // wakeup handler of the proxy task
+	}        pxy;
+	#define _TSK_PXY { NULL, NULL },
+#else
+	#define _TSK_PXY
+#endif
+#if OS_OBJECT_STATS
+	cyc_t    wait;  // value of the cycle counter at the beginning of the blocking wait
+	#define _TSK_WAIT 0,
+#else
+	#define _TSK_WAIT
+#endif
+#if OS_TASK_STATS
+	struct {
+	uint64_t time;     // total run time (in cycles)
+	cyc_t    start;    // value of the cycle counter at the last switch to the task
+	cyc_t    max;      // longest single run (in cycles)
+	unsigned switches; // number of switches to the task
+	unsigned preempts; // number of switches from the task while it was still ready
+	}        stat;
+	#define _TSK_STATS { 0, 0, 0, 0, 0 }
+#else
+	#define _TSK_STATS
+#endif
 };
 
 #ifdef __cplusplus
@@ -193,10 +241,47 @@ struct tsk_T { tsk_t tsk; stk_t buf[STK_SIZE(limit_)]; };
 struct tsk_T { tsk_t tsk; stk_t buf[]; };
 #endif
 
+/******************************************************************************
+ *
+ * Name              : task statistics
+ *
+ ******************************************************************************/
+
+typedef struct __tst tst_t;
+
+struct __tst
+{
+	uint64_t time;     // total run time (in cycles of frequency CYC_FREQUENCY)
+	uint64_t max;      // longest single run (in cycles of frequency CYC_FREQUENCY)
+	unsigned switches; // number of switches to the task
+	unsigned preempts; // number of switches from the task while it was still ready (preemption or yield)
+};
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/******************************************************************************
+ *
+ * Name              : _TSK_PRIO
+ *
+ * Description       : limit the task priority to the priority levels of the tasks' queue
+ *
+ * Parameters
+ *   prio            : task priority (any unsigned int value)
+ *
+ * Return            : task priority, limited to OS_PRIO_LEVELS - 1 when OS_PRIO_LEVELS > 0
+ *
+ * Note              : for internal use
+ *
+ ******************************************************************************/
+
+#if OS_PRIO_LEVELS
+#define               _TSK_PRIO( _prio ) ( (_prio) < (OS_PRIO_LEVELS) ? (_prio) : (OS_PRIO_LEVELS) - 1U )
+#else
+#define               _TSK_PRIO( _prio ) (_prio)
+#endif
+
 /******************************************************************************
  *
  * Name              : _TSK_INIT
@@ -217,8 +302,8 @@ extern "C" {
  ******************************************************************************/
 
 #define               _TSK_INIT( _prio, _state, _stack, _size ) \
-                       { _HDR_INIT(), _FUN_INIT(_state), 0, 0, 0, NULL, _stack, _size, NULL, _prio, _prio, NULL, NULL, 0, \
-                       { NULL, NULL }, { 0, _ACT_INIT(), { NULL, NULL } }, { { NULL } }, _TSK_EXTRA }
+                       { _HDR_INIT(), _FUN_INIT(_state), 0, 0, 0, NULL, _stack, _size, NULL, _TSK_PRIO(_prio), _TSK_PRIO(_prio), _BLQ_INIT(), NULL, 0, \
+                       { NULL, NULL }, { 0, _ACT_INIT(), { NULL, NULL } }, { { NULL } }, _TSK_EXTRA _TSK_STK _TSK_SHR _TSK_PXY _TSK_WAIT _TSK_STATS }
 
 /******************************************************************************
  *
@@ -646,6 +731,69 @@ tsk_t *cur_task( void ) { return System.cur; }
 
 void tsk_init( tsk_t *tsk, unsigned prio, fun_t *state, stk_t *stack, unsigned size );
 
+/******************************************************************************
+ *
+ * Name              : tsk_initShared
+ *
+ * Description       : initialize complete work area for run-to-completion task object and start the task
+ *                     the task is dispatched on the stack shared by all run-to-completion tasks of the same priority,
+ *                     it holds the stack only while its state is executed and preempted by the tasks of higher priority
+ *                     blocking function called by the task ends the run of the task (the rest of the task state is not executed),
+ *                     the task state is executed again from the beginning when the wait is over, the result of the wait is in the 'event' field
+ *                     buffers passed to the blocking functions must not be located on the stack
+ *                     priority of the task is fixed (priority inheritance and 'tsk_setPrio' don't change it),
+ *                     round-robin scheduling and 'tsk_yield' take effect only after the task state has returned,
+ *                     the task preempted by the tasks of higher priority cannot be suspended ('tsk_suspend' returns E_FAILURE)
+ *
+ * Parameters
+ *   tsk             : pointer to task object
+ *   prio            : task priority (all tasks sharing the stack must have the same priority)
+ *   state           : task state (initial task function) must return
+ *                     it will be executed into an infinite system-implemented loop
+ *   stack           : base of the shared stack storage
+ *   size            : size of the shared stack (in bytes)
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *                     available only when OS_STACK_SHARED > 0
+ *
+ ******************************************************************************/
+
+#if OS_STACK_SHARED
+void tsk_initShared( tsk_t *tsk, unsigned prio, fun_t *state, stk_t *stack, unsigned size );
+#endif
+
+/******************************************************************************
+ *
+ * Name              : tsk_proxy
+ *
+ * Description       : delegate the next blocking wait of the current task to the proxy task
+ *                     the proxy task is put into the BLOCKED queue of the object instead of the current task,
+ *                     blocking function returns immediately with E_TIMEOUT;
+ *                     when the wait is over, the result of the wait is in the 'event' field of the proxy task
+ *                     and the wakeup handler is called instead of resuming the task
+ *                     buffers passed to the blocking function must be valid until the wait is over
+ *
+ * Parameters
+ *   pxy             : pointer to the proxy task object (control block only, without stack),
+ *                     zero-initialized or not waiting
+ *                     NULL: cancel the delegation
+ *   fun             : wakeup handler of the proxy task, called with the kernel locked (also in handler mode)
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *                     the proxy task is waiting while its 'guard' field is not NULL,
+ *                     waiting proxy task can be removed from the BLOCKED queue with 'tsk_reset' function
+ *                     available only when OS_TASK_PROXY > 0
+ *
+ ******************************************************************************/
+
+#if OS_TASK_PROXY
+void tsk_proxy( tsk_t *pxy, void (*fun)( tsk_t * ) );
+#endif
+
 /******************************************************************************
  *
  * Name              : wrk_create
@@ -1116,6 +1264,8 @@ void tsk_sleep( void ) { tsk_sleepFor(INFINITE); }
  *   E_FAILURE       : task cannot be suspended
  *
  * Note              : use only in thread mode
+ *                     run-to-completion task preempted while holding the frame on the shared stack cannot be suspended,
+ *                     because the suspension would discard the frame and restart the run of the task
  *
  ******************************************************************************/
 
@@ -1244,6 +1394,51 @@ void tsk_action( tsk_t *tsk, act_t *action );
 __STATIC_INLINE
 void cur_action( act_t *action ) { tsk_action(System.cur, action); }
 
+/******************************************************************************
+ *
+ * Name              : tsk_stats
+ *
+ * Description       : get run time statistics of given task
+ *
+ * Parameters
+ *   tsk             : pointer to the task object
+ *   stats           : pointer to the task statistics structure
+ *
+ * Return            : none
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     available only when OS_TASK_STATS > 0
+ *
+ ******************************************************************************/
+
+#if OS_TASK_STATS
+void tsk_stats( tsk_t *tsk, tst_t *stats );
+#endif
+
+/******************************************************************************
+ *
+ * Name              : tsk_stackUsed
+ *
+ * Description       : get the high-water mark of the stack of given task
+ *                     stack of the task is painted at the start and scanned incrementally by the idle task,
+ *                     so the result may not include the stack usage since the last scan of the task stack
+ *
+ * Parameters
+ *   tsk             : pointer to the task object
+ *
+ * Return            : maximum number of stack bytes used by the task (including the initial context)
+ *                     stack size of the task means the stack has overflowed
+ *                     0 for the main, idle and run-to-completion tasks (their stacks are not scanned)
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     available only when OS_STACK_SCAN > 0
+ *
+ ******************************************************************************/
+
+#if OS_STACK_SCAN
+unsigned tsk_stackUsed( tsk_t *tsk );
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -1302,6 +1497,12 @@ struct baseTask : public __tsk
 	                                                tsk_action   (this, act_);    }
 #else
 	void     action   ( ACT_t    _action ) {        tsk_action   (this, _action); }
+#endif
+#if OS_TASK_STATS
+	void     stats    ( tst_t   *_stats )  {        tsk_stats    (this, _stats);  }
+#endif
+#if OS_STACK_SCAN
+	unsigned stackUsed( void )             { return tsk_stackUsed(this);          }
 #endif
 	bool     operator!( void )             { return __tsk::hdr.id == ID_STOPPED;  }
 #if OS_FUNCTIONAL
@@ -1393,6 +1594,31 @@ struct startTaskT : public TaskT<size_>
 
 typedef startTaskT<OS_STACK_SIZE> startTask;
 
+/******************************************************************************
+ *
+ * Class             : SharedTask
+ *
+ * Description       : create and initialize run-to-completion task object dispatched on the shared stack
+ *                     (see 'tsk_initShared' function)
+ *
+ * Constructor parameters
+ *   prio            : task priority (all tasks sharing the stack must have the same priority)
+ *   state           : task state (initial task function) must return
+ *                     it will be executed into an infinite system-implemented loop
+ *   stack           : shared stack storage (array of stk_t)
+ *
+ * Note              : available only when OS_STACK_SHARED > 0
+ *
+ ******************************************************************************/
+
+#if OS_STACK_SHARED
+struct SharedTask : public baseTask
+{
+	template<size_t size_>
+	SharedTask( const unsigned _prio, FUN_t _state, stk_t (&_stack)[size_] ): baseTask(_prio, _state, _stack, sizeof(_stack)) { __tsk::shr.mode = true; }
+};
+#endif
+
 /******************************************************************************
  *
  * Namespace         : ThisTask
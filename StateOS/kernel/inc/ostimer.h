@@ -34,6 +34,11 @@
 
 #include "oskernel.h"
 
+/* -------------------------------------------------------------------------- */
+
+#define tmrISR       ( 0U ) // callback procedure is executed in the timer interrupt
+#define tmrDaemon    ( 1U ) // callback procedure is executed by the timer daemon (OS_TIMER_DAEMON)
+
 /******************************************************************************
  *
  * Name              : timer
@@ -58,6 +63,19 @@ struct __tmr
 	cnt_t    start;
 	cnt_t    delay;
 	cnt_t    period;
+#if OS_TIMER_DAEMON
+	struct {
+	unsigned mode;  // execution mode of the callback procedure: tmrISR or tmrDaemon
+	tmr_t  * next;  // next timer in the queue of the timer daemon
+	tmr_t ** back;  // previous link in the queue of the timer daemon; NULL => no pending callback
+	cyc_t    stamp; // value of the cycle counter when the pending callback was queued
+	cyc_t    lag;   // maximum dispatch lag of the callback procedure (in cycles, frequency CYC_FREQUENCY)
+	cyc_t    run;   // maximum runtime of the callback procedure (in cycles, frequency CYC_FREQUENCY)
+	}        dmn;
+#define     _DMN_INIT( _mode ) , { _mode, NULL, NULL, 0, 0, 0 }
+#else
+#define     _DMN_INIT( _mode )
+#endif
 };
 
 #ifdef __cplusplus
@@ -80,7 +98,26 @@ extern "C" {
  *
  ******************************************************************************/
 
-#define               _TMR_INIT( _state ) { _HDR_INIT(), _FUN_INIT(_state), 0, 0, 0 }
+#define               _TMR_INIT( _state ) { _HDR_INIT(), _FUN_INIT(_state), 0, 0, 0 _DMN_INIT(tmrISR) }
+
+/******************************************************************************
+ *
+ * Name              : _TMR_INIT_DMN
+ *
+ * Description       : create and initialize a timer object with the callback procedure executed by the timer daemon
+ *
+ * Parameters
+ *   state           : callback procedure
+ *                     0: no callback
+ *
+ * Return            : timer object
+ *
+ * Note              : for internal use
+ *                     same as _TMR_INIT if OS_TIMER_DAEMON is disabled
+ *
+ ******************************************************************************/
+
+#define               _TMR_INIT_DMN( _state ) { _HDR_INIT(), _FUN_INIT(_state), 0, 0, 0 _DMN_INIT(tmrDaemon) }
 
 /******************************************************************************
  *
@@ -310,8 +347,13 @@ extern "C" {
  *
  ******************************************************************************/
 
+#if OS_TIMER_DAEMON
+__STATIC_INLINE
+tmr_t *tmr_thisISR( void ) { return port_isr_context() ? (tmr_t *) WAIT.hdr.next : System.dmn; }
+#else
 __STATIC_INLINE
 tmr_t *tmr_thisISR( void ) { return (tmr_t *) WAIT.hdr.next; }
+#endif
 
 /******************************************************************************
  *
@@ -676,6 +718,36 @@ unsigned tmr_waitUntil( tmr_t *tmr, cnt_t time );
 __STATIC_INLINE
 unsigned tmr_wait( tmr_t *tmr ) { return tmr_waitFor(tmr, INFINITE); }
 
+/******************************************************************************
+ *
+ * Name              : tmr_setMode
+ *
+ * Description       : select execution mode of the timer callback procedure
+ *
+ * Parameters
+ *   tmr             : pointer to timer object
+ *   mode            : execution mode of the callback procedure
+ *                     tmrISR:    callback procedure is executed in the timer interrupt
+ *                     tmrDaemon: callback procedure is executed by the timer daemon
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *                     mode is ignored if OS_TIMER_DAEMON is disabled
+ *                     expiration of the timer in daemon mode is queued in the timer interrupt in O(1) time
+ *                     and the callback procedure is executed later by the timer daemon task (priority OS_TIMER_DAEMON)
+ *                     tasks waiting for the timer are released at the expiration, before the callback procedure is executed
+ *                     expirations of the timer that occur while its callback procedure is still pending are coalesced
+ *                     tmr_delayISR has no effect in daemon mode
+ *                     the maximum dispatch lag (dmn.lag) and the maximum runtime (dmn.run) of the callback procedure are
+ *                     measured with the cycle counter (in cycles, frequency CYC_FREQUENCY)
+ *                     the mode is kept by tmr_start* functions, tmr_init resets it to tmrISR,
+ *                     a static timer object can be created in daemon mode with _TMR_INIT_DMN
+ *
+ ******************************************************************************/
+
+void tmr_setMode( tmr_t *tmr, unsigned mode );
+
 /******************************************************************************
  *
  * Name              : tmr_flipISR
@@ -773,6 +845,7 @@ struct Timer : public __tmr
 	void startNext    ( cnt_t _delay )                              {        tmr_startNext    (this, _delay);                  }
 	void startUntil   ( cnt_t _time )                               {        tmr_startUntil   (this, _time);                   }
 	void stop         ( void )                                      {        tmr_stop         (this);                          }
+	void setMode      ( unsigned _mode )                            {        tmr_setMode      (this, _mode);                   }
 
 	unsigned take     ( void )                                      { return tmr_take         (this);                          }
 	unsigned tryWait  ( void )                                      { return tmr_tryWait      (this);                          }
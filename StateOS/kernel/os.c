@@ -29,7 +29,7 @@
 
  ******************************************************************************/
 
-#include "oskernel.h"
+#include "os.h"
 #include "inc/oscriticalsection.h"
 
 /* -------------------------------------------------------------------------- */
@@ -48,3 +48,37 @@ cnt_t sys_time( void )
 }
 
 /* -------------------------------------------------------------------------- */
+#if OS_TASK_STATS
+void sys_stats( sst_t *stats )
+/* -------------------------------------------------------------------------- */
+{
+	tst_t idle;
+
+	assert(stats);
+
+	sys_lock();
+	{
+		tsk_stats(&IDLE, &idle);
+
+		stats->switches = System.stat.switches;
+		stats->wakeups  = System.stat.wakeups;
+		stats->timers   = System.stat.timers;
+		stats->idle     = idle.time;
+	}
+	sys_unlock();
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
+#if OS_OBJECT_STATS
+void sys_objectStats( const void *obj, ost_t *stats )
+/* -------------------------------------------------------------------------- */
+{
+	assert(obj);
+	assert(stats);
+
+	core_obj_stats(obj, stats);
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
@@ -46,6 +46,7 @@
 
 #include "oskernel.h"
 #include "osalloc.h"
+#include "ostrace.h"
 #include "inc/oscriticalsection.h"
 #include "inc/osspinlock.h"
 #include "inc/osonceflag.h"
@@ -66,6 +67,7 @@
 #include "inc/osjobqueue.h"
 #include "inc/ostimer.h"
 #include "inc/ostask.h"
+#include "inc/oscoroutine.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -109,6 +111,111 @@ cnt_t sys_time( void );
 __STATIC_INLINE
 cnt_t sys_timeISR( void ) { return sys_time(); }
 
+/******************************************************************************
+ *
+ * Name              : system statistics
+ *
+ ******************************************************************************/
+
+typedef struct __sst sst_t;
+
+struct __sst
+{
+	unsigned switches; // number of context switches
+	unsigned wakeups;  // number of task wakeups
+	unsigned timers;   // number of timer expirations
+	uint64_t idle;     // total run time of the idle task (in cycles of frequency CYC_FREQUENCY)
+};
+
+/******************************************************************************
+ *
+ * Name              : sys_stats
+ *
+ * Description       : get run time statistics of the system
+ *
+ * Parameters
+ *   stats           : pointer to the system statistics structure
+ *
+ * Return            : none
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     available only when OS_TASK_STATS > 0
+ *
+ ******************************************************************************/
+
+#if OS_TASK_STATS
+void sys_stats( sst_t *stats );
+#endif
+
+/******************************************************************************
+ *
+ * Name              : sys_objectNext
+ *
+ * Description       : iterate over the objects with statistics
+ *                     object is recorded at its first take / give request
+ *                     and forgotten when it is initialized, reset or its resources are released
+ *
+ * Parameters
+ *   obj             : pointer to the previous object
+ *                     NULL: get the first object
+ *
+ * Return            : pointer to the next object (the object header is the first field of the object)
+ *   NULL            : no more objects
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     at most OS_OBJECT_STATS objects are recorded, see sys_objectLost
+ *                     static and automatic objects must be reset before their memory is reused
+ *                     available only when OS_OBJECT_STATS > 0
+ *
+ ******************************************************************************/
+
+#if OS_OBJECT_STATS
+__STATIC_INLINE
+void *sys_objectNext( const void *obj ) { return core_obj_next(obj); }
+#endif
+
+/******************************************************************************
+ *
+ * Name              : sys_objectStats
+ *
+ * Description       : get statistics of any object returned by sys_objectNext
+ *
+ * Parameters
+ *   obj             : pointer to the object
+ *   stats           : pointer to the object statistics structure
+ *
+ * Return            : none
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     available only when OS_OBJECT_STATS > 0
+ *
+ ******************************************************************************/
+
+#if OS_OBJECT_STATS
+void sys_objectStats( const void *obj, ost_t *stats );
+#endif
+
+/******************************************************************************
+ *
+ * Name              : sys_objectLost
+ *
+ * Description       : get the number of objects not recorded because the table of objects with statistics was full
+ *
+ * Parameters        : none
+ *
+ * Return            : number of objects not recorded
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     statistics of objects not recorded are still available with the object-specific functions
+ *                     available only when OS_OBJECT_STATS > 0
+ *
+ ******************************************************************************/
+
+#if OS_OBJECT_STATS
+__STATIC_INLINE
+unsigned sys_objectLost( void ) { return core_obj_lost(); }
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -32,11 +32,784 @@
 #include "osalloc.h"
 #include "inc/oscriticalsection.h"
 
+/* -------------------------------------------------------------------------- */
+// SYSTEM HEAP STATISTICS
+/* -------------------------------------------------------------------------- */
+
+// heap statistics are updated in constant time with every alloc / free
+// the modification counter lets the heap walker detect changes of the heap
+
+static
+struct
+{
+	hsi_t    info;  // heap statistics
+	unsigned gen;   // heap modification counter
+}	Stat = { { SEG_OVER(OS_HEAP_SIZE), 0, 0, 0, 0, 0, 0, 0, 0, 0 }, 0 };
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_stat_update( size_t add, size_t sub )
+{
+	Stat.gen++;
+	Stat.info.used = Stat.info.used + add - sub;
+	if (Stat.info.max_used < Stat.info.used)
+		Stat.info.max_used = Stat.info.used;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_stat_alloc( void *mem, size_t size )
+{
+	if (mem == NULL)
+	{
+		Stat.gen++;
+		Stat.info.failures++;
+		return;
+	}
+
+	Stat.info.allocs++;
+	priv_stat_update(size, 0);
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_stat_free( size_t size )
+{
+	Stat.info.frees++;
+	priv_stat_update(0, size);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void sys_heapInfo( hsi_t *info )
+{
+	assert(info);
+
+	sys_lock();
+	{
+		*info = Stat.info;
+		info->free = info->size - info->used;
+	}
+	sys_unlock();
+}
+
 /* -------------------------------------------------------------------------- */
 // SYSTEM ALLOC/FREE SERVICES
 /* -------------------------------------------------------------------------- */
 
-#if OS_HEAP_SIZE
+#if (OS_HEAP_SIZE && OS_HEAP_TLSF) || OS_HEAP_REGIONS
+
+// two-level segregated fit allocator
+// free blocks are kept in segregated lists indexed by the first-level (power of two)
+// and the second-level (linear subdivision) of the block size; non-empty lists are
+// marked in the bitmaps, so both allocation and release are performed in constant time
+// links of the free list are placed at the end of the free block, so the beginning
+// of the released object (e.g. the object header) remains intact
+// the allocator manages the TLSF system heap and the additional heap regions
+
+#define BLK_SLL      4                          // log2 of the number of second-level lists
+#define BLK_SLC     (1U << BLK_SLL)             // number of second-level lists
+#define BLK_HDR      sizeof(seg_t)              // size of the block header
+#define BLK_MIN     (sizeof(seg_t) + SEG_OVER(sizeof(lnk_t))) // minimum size of the block
+#define BLK_SMALL   (BLK_SLC * sizeof(seg_t))   // blocks smaller than BLK_SMALL are kept in the first-level list 0
+#define BLK_FREE     1U                         // flag of the free block (in the size field)
+
+#define BLK_MSB2(x)  ((x) & 0x2UL ? 1 : 0)
+#define BLK_MSB4(x)  ((x) & 0xCUL ? 2 + BLK_MSB2((x) >> 2) : BLK_MSB2(x))
+#define BLK_MSB8(x)  ((x) & 0xF0UL ? 4 + BLK_MSB4((x) >> 4) : BLK_MSB4(x))
+#define BLK_MSB16(x) ((x) & 0xFF00UL ? 8 + BLK_MSB8((x) >> 8) : BLK_MSB8(x))
+#define BLK_MSB(x)   ((x) & 0xFFFF0000UL ? 16 + BLK_MSB16((x) >> 16) : BLK_MSB16(x))
+
+#define BLK_FLC     (BLK_MSB(SEG_OVER(OS_HEAP_SIZE)) < BLK_MSB(BLK_SMALL) ? 1 : BLK_MSB(SEG_OVER(OS_HEAP_SIZE)) - BLK_MSB(BLK_SMALL) + 2)
+
+typedef struct __blk blk_t;
+typedef struct __lnk lnk_t;
+typedef struct __tlsf tlsf_t;
+
+// block header (the same size as seg_t)
+
+struct __blk
+{
+	blk_t  * prev;  // previous physical block
+	size_t   size;  // size of the block (including header) and the free block flag
+};
+
+// links of the free list (only for free blocks)
+
+struct __lnk
+{
+	blk_t  * next;  // next block in the free list
+	blk_t  * prev;  // previous block in the free list
+};
+
+// memory pool managed by the allocator
+
+struct __tlsf
+{
+	blk_t  * heap;      // first block of the pool (NULL => pool not initialized)
+	blk_t  * end;       // sentinel block at the end of the pool
+	unsigned flc;       // number of first-level lists
+	uint32_t fl_map;    // non-empty first-level lists
+	uint32_t*sl_map;    // non-empty second-level lists [flc]
+	blk_t ** free;      // free lists [flc][BLK_SLC]
+};
+
+#if OS_HEAP_SIZE && OS_HEAP_TLSF
+
+static
+seg_t Heap[SEG_SIZE(OS_HEAP_SIZE)+1];
+
+static
+uint32_t HeapMap[BLK_FLC];
+
+static
+blk_t *HeapFree[BLK_FLC * BLK_SLC];
+
+static
+tlsf_t Tlsf = { NULL, NULL, BLK_FLC, 0, HeapMap, HeapFree };
+
+#endif
+
+#if OS_HEAP_REGIONS
+
+static
+tlsf_t Region[OS_HEAP_REGIONS];
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+static
+unsigned priv_msb( size_t size )
+{
+#if defined(__GNUC__)
+	return (unsigned)(sizeof(unsigned long long) * CHAR_BIT - 1) - (unsigned)__builtin_clzll(size);
+#else
+	unsigned bit = 0;
+	while (size >>= 1) bit++;
+	return bit;
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+unsigned priv_lsb( uint32_t map )
+{
+	unsigned bit = 0;
+#if defined(__GNUC__) && (UINT_MAX == 0xFFFFFFFFU)
+	bit = (unsigned)__builtin_ctz(map);
+#else
+	while ((map & 1) == 0) { map >>= 1; bit++; }
+#endif
+	return bit;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+size_t priv_blk_size( blk_t *blk )
+{
+	return blk->size & ~(size_t)BLK_FREE;
+}
+
+static
+bool priv_blk_free( blk_t *blk )
+{
+	return (blk->size & BLK_FREE) != 0;
+}
+
+static
+blk_t *priv_blk_next( blk_t *blk )
+{
+	return (blk_t *)((char *)blk + priv_blk_size(blk));
+}
+
+static
+lnk_t *priv_blk_link( blk_t *blk )
+{
+	return (lnk_t *)((char *)priv_blk_next(blk) - sizeof(lnk_t));
+}
+
+static
+blk_t *priv_blk_head( void *base )
+{
+	return (blk_t *)((char *)base - BLK_HDR);
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_blk_mapping( size_t size, unsigned *fl, unsigned *sl )
+{
+	unsigned bit;
+
+	if (size < BLK_SMALL)
+	{
+		*fl = 0;
+		*sl = (unsigned)(size / sizeof(seg_t));
+	}
+	else
+	{
+		bit = priv_msb(size);
+		*fl = bit - (unsigned)BLK_MSB(BLK_SMALL) + 1;
+		*sl = (unsigned)(size >> (bit - BLK_SLL)) ^ BLK_SLC;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_blk_insert( tlsf_t *pool, blk_t *blk )
+{
+	unsigned fl, sl;
+	blk_t *nxt;
+
+	priv_blk_mapping(priv_blk_size(blk), &fl, &sl);
+
+	nxt = pool->free[fl * BLK_SLC + sl];
+	priv_blk_link(blk)->next = nxt;
+	priv_blk_link(blk)->prev = NULL;
+	if (nxt) priv_blk_link(nxt)->prev = blk;
+	pool->free[fl * BLK_SLC + sl] = blk;
+
+	pool->fl_map     |= 1UL << fl;
+	pool->sl_map[fl] |= 1UL << sl;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_blk_remove( tlsf_t *pool, blk_t *blk )
+{
+	unsigned fl, sl;
+	blk_t *nxt = priv_blk_link(blk)->next;
+	blk_t *prv = priv_blk_link(blk)->prev;
+
+	priv_blk_mapping(priv_blk_size(blk), &fl, &sl);
+
+	if (nxt) priv_blk_link(nxt)->prev = prv;
+	if (prv) priv_blk_link(prv)->next = nxt;
+	else
+	if ((pool->free[fl * BLK_SLC + sl] = nxt) == NULL)
+	{
+		pool->sl_map[fl] &= ~(1UL << sl);
+		if (pool->sl_map[fl] == 0)
+			pool->fl_map &= ~(1UL << fl);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+blk_t *priv_blk_search( tlsf_t *pool, size_t size )
+{
+	unsigned fl, sl;
+	uint32_t map;
+
+	if (size >= BLK_SMALL)
+	//	round up to the next list, so that any block of the list fits
+		size += ((size_t)1 << (priv_msb(size) - BLK_SLL)) - 1;
+
+	priv_blk_mapping(size, &fl, &sl);
+
+	if (fl >= pool->flc)
+		return NULL;
+
+	map = pool->sl_map[fl] & ~((1UL << sl) - 1);
+	if (map == 0)
+	{
+		map = pool->fl_map & ~((2UL << fl) - 1);
+		if (map == 0)
+			return NULL;
+		fl = priv_lsb(map);
+		map = pool->sl_map[fl];
+	}
+	sl = priv_lsb(map);
+
+	return pool->free[fl * BLK_SLC + sl];
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_blk_init( tlsf_t *pool, void *base, size_t size )
+{
+	blk_t *blk = base;
+	blk_t *end = (blk_t *)((char *)base + size - BLK_HDR);
+
+	blk->prev = NULL;
+	blk->size = (size_t)((char *)end - (char *)blk) | BLK_FREE;
+	end->prev = blk;
+	end->size = 0;
+	//	the sentinel block of zero size is permanently allocated
+
+	pool->heap = blk;
+	pool->end  = end;
+	priv_blk_insert(pool, blk);
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_blk_split( tlsf_t *pool, blk_t *blk, size_t size )
+{
+	blk_t *nxt;
+	size_t rem = priv_blk_size(blk) - size;
+
+	if (rem < BLK_MIN)
+	//	the rest is too small to become a separate block
+		return;
+
+	nxt = (blk_t *)((char *)blk + size);
+	nxt->prev = blk;
+	nxt->size = rem | BLK_FREE;
+	priv_blk_next(nxt)->prev = nxt;
+	blk->size = size | (blk->size & BLK_FREE);
+
+	if (priv_blk_free(priv_blk_next(nxt)))
+	//	merge with the next free block
+	{
+		blk = priv_blk_next(nxt);
+		priv_blk_remove(pool, blk);
+		nxt->size += priv_blk_size(blk);
+		priv_blk_next(nxt)->prev = nxt;
+	}
+
+	priv_blk_insert(pool, nxt);
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+size_t priv_blk_adjust( size_t size )
+{
+	if (size > SIZE_MAX / 2)
+		return 0;
+
+	size = SEG_OVER(size) + BLK_HDR;
+
+	return size < BLK_MIN ? BLK_MIN : size;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void *priv_alloc( tlsf_t *pool, size_t size, size_t align )
+{
+	blk_t *blk;
+	blk_t *prv;
+	size_t gap;
+
+	blk = size ? priv_blk_search(pool, align ? size + align + BLK_MIN : size) : NULL;
+	if (blk == NULL)
+		return NULL;
+
+	priv_blk_remove(pool, blk);
+
+	if (align)
+	//	separate the leading part of the block, so that the data is aligned
+	{
+		gap = (align - (uintptr_t)((char *)blk + BLK_HDR) % align) % align;
+		if (gap != 0 && gap < BLK_MIN)
+			gap += (BLK_MIN - gap + align - 1) / align * align;
+
+		if (gap != 0)
+		{
+			prv = blk;
+			blk = (blk_t *)((char *)prv + gap);
+			blk->prev = prv;
+			blk->size = priv_blk_size(prv) - gap;
+			priv_blk_next(blk)->prev = blk;
+			prv->size = gap | BLK_FREE;
+			priv_blk_insert(pool, prv);
+		}
+	}
+
+	blk->size &= ~(size_t)BLK_FREE;
+	priv_blk_split(pool, blk, size);
+	priv_stat_alloc(blk, priv_blk_size(blk));
+
+	return (char *)blk + BLK_HDR;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_free( tlsf_t *pool, blk_t *blk )
+{
+	blk_t *nxt = priv_blk_next(blk);
+	blk_t *prv = blk->prev;
+
+	assert(!priv_blk_free(blk));
+
+	priv_stat_free(blk->size);
+
+	if (prv && priv_blk_free(prv))
+	//	merge with the previous free block
+	{
+		priv_blk_remove(pool, prv);
+		prv->size += blk->size;
+		blk = prv;
+	}
+
+	if (priv_blk_free(nxt))
+	//	merge with the next free block
+	{
+		priv_blk_remove(pool, nxt);
+		blk->size += priv_blk_size(nxt);
+	}
+
+	blk->size |= BLK_FREE;
+	priv_blk_next(blk)->prev = blk;
+	priv_blk_insert(pool, blk);
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void *priv_realloc( tlsf_t *pool, blk_t *blk, size_t size )
+{
+	blk_t *nxt = priv_blk_next(blk);
+	size_t old = priv_blk_size(blk);
+	void  *mem;
+
+	if (priv_blk_size(blk) < size && priv_blk_free(nxt) && priv_blk_size(blk) + priv_blk_size(nxt) >= size)
+	//	extend the block with the next free block
+	{
+		priv_blk_remove(pool, nxt);
+		blk->size += priv_blk_size(nxt);
+		priv_blk_next(blk)->prev = blk;
+	}
+
+	if (priv_blk_size(blk) >= size)
+	{
+		priv_blk_split(pool, blk, size);
+		priv_stat_update(priv_blk_size(blk), old);
+		return (char *)blk + BLK_HDR;
+	}
+
+	mem = priv_alloc(pool, size, 0);
+	if (mem != NULL)
+	{
+		memcpy(mem, (char *)blk + BLK_HDR, priv_blk_size(blk) - BLK_HDR);
+		priv_free(pool, blk);
+	}
+
+	return mem;
+}
+
+/* -------------------------------------------------------------------------- */
+
+#if OS_HEAP_REGIONS
+
+static
+tlsf_t *priv_region( void *base )
+{
+	tlsf_t *pool;
+
+	for (pool = Region; pool < Region + OS_HEAP_REGIONS; pool++)
+		if (pool->heap != NULL && (char *)base > (char *)pool->heap && (char *)base < (char *)pool->end)
+			return pool;
+
+	return NULL;
+}
+
+/* -------------------------------------------------------------------------- */
+
+unsigned sys_regionAdd( unsigned region, void *base, size_t size )
+{
+	tlsf_t  *pool;
+	char    *mem = base;
+	size_t   len;
+	unsigned flc;
+	unsigned event = E_FAILURE;
+
+	assert(base);
+
+	if (region < 1 || region > OS_HEAP_REGIONS)
+		return E_FAILURE;
+
+	pool = &Region[region - 1];
+
+	len  = (size_t)(-(uintptr_t)mem % sizeof(seg_t));
+	if (size < len)
+		return E_FAILURE;
+	mem += len;
+	size = (size - len) / sizeof(seg_t) * sizeof(seg_t);
+
+	//	the control structure of the pool is placed at the beginning of the region
+	flc  = priv_msb(size) < (unsigned)BLK_MSB(BLK_SMALL) ? 1 : priv_msb(size) - (unsigned)BLK_MSB(BLK_SMALL) + 2;
+	len  = SEG_OVER(flc * sizeof(uint32_t)) + SEG_OVER(flc * BLK_SLC * sizeof(blk_t *));
+	if (size < len + BLK_MIN + BLK_HDR)
+		return E_FAILURE;
+
+	sys_lock();
+	{
+		if (pool->heap == NULL)
+		{
+			pool->flc    = flc;
+			pool->fl_map = 0;
+			pool->sl_map = memset(mem, 0, len);
+			pool->free   = (blk_t **)(mem + SEG_OVER(flc * sizeof(uint32_t)));
+			priv_blk_init(pool, mem + len, size - len);
+			Stat.info.size += size - len;
+			event = E_SUCCESS;
+		}
+	}
+	sys_unlock();
+
+	return event;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void *sys_allocIn( unsigned region, size_t size )
+{
+	void *mem = NULL;
+
+	assert(size);
+
+	if (region >= 1 && region <= OS_HEAP_REGIONS && Region[region - 1].heap != NULL)
+	{
+		sys_lock();
+		{
+			mem = priv_alloc(&Region[region - 1], priv_blk_adjust(size), 0);
+		}
+		sys_unlock();
+	}
+
+	if (mem == NULL)
+	//	region is not available or exhausted, use the system heap
+		return sys_alloc(size);
+
+	return memset(mem, 0, size);
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+bool priv_region_free( void *base )
+{
+	tlsf_t *pool = priv_region(base);
+
+	if (pool == NULL)
+		return false;
+
+	sys_lock();
+	{
+		priv_free(pool, priv_blk_head(base));
+	}
+	sys_unlock();
+
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void *priv_region_realloc( void *base, size_t size )
+{
+	tlsf_t *pool = priv_region(base);
+	void   *mem;
+	size_t  len;
+
+	if (pool == NULL)
+		return NULL;
+
+	sys_lock();
+	{
+		len = priv_blk_size(priv_blk_head(base)) - BLK_HDR;
+		mem = priv_realloc(pool, priv_blk_head(base), priv_blk_adjust(size));
+	}
+	sys_unlock();
+
+	if (mem == NULL)
+	//	region is exhausted, move the memory segment to the system heap
+	{
+		mem = sys_alloc(size);
+		if (mem != NULL)
+		{
+			memcpy(mem, base, len < size ? len : size);
+			priv_region_free(base);
+		}
+	}
+
+	return mem;
+}
+
+#endif // OS_HEAP_REGIONS
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#if OS_HEAP_REGIONS == 0
+
+unsigned sys_regionAdd( unsigned region, void *base, size_t size )
+{
+	(void) region;
+	(void) base;
+	(void) size;
+
+	return E_FAILURE;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void *sys_allocIn( unsigned region, size_t size )
+{
+	(void) region;
+
+	return sys_alloc(size);
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#if OS_HEAP_SIZE && OS_HEAP_TLSF
+
+void *sys_alloc( size_t size )
+{
+	void *mem;
+
+	assert(size);
+
+	size = priv_blk_adjust(size);
+
+	sys_lock();
+	{
+		if (Tlsf.heap == NULL)
+			priv_blk_init(&Tlsf, Heap, sizeof(Heap));
+		mem = priv_alloc(&Tlsf, size, 0);
+		if (mem == NULL)
+			priv_stat_alloc(NULL, 0);
+	}
+	sys_unlock();
+
+	if (mem)
+		mem = memset(mem, 0, size - BLK_HDR);
+
+	assert(mem);
+
+	return mem;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void *sys_alignedAlloc( size_t align, size_t size )
+{
+	void *mem;
+
+	assert(size);
+	assert(align && (align & (align - 1)) == 0);
+
+	size = priv_blk_adjust(size);
+
+	if (align <= sizeof(seg_t))
+		align = 0;
+
+	sys_lock();
+	{
+		if (Tlsf.heap == NULL)
+			priv_blk_init(&Tlsf, Heap, sizeof(Heap));
+		mem = priv_alloc(&Tlsf, size, align);
+		if (mem == NULL)
+			priv_stat_alloc(NULL, 0);
+	}
+	sys_unlock();
+
+	if (mem)
+		mem = memset(mem, 0, size - BLK_HDR);
+
+	assert(mem);
+
+	return mem;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void *sys_realloc( void *base, size_t size )
+{
+	void *mem;
+
+	if (base == NULL)
+		return sys_alloc(size);
+
+	assert(size);
+
+#if OS_HEAP_REGIONS
+	if (priv_region(base) != NULL)
+		return priv_region_realloc(base, size);
+#endif
+
+	size = priv_blk_adjust(size);
+
+	sys_lock();
+	{
+		mem = size ? priv_realloc(&Tlsf, priv_blk_head(base), size) : NULL;
+		if (mem == NULL)
+			priv_stat_alloc(NULL, 0);
+	}
+	sys_unlock();
+
+	assert(mem);
+
+	return mem;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void sys_free( void *base )
+{
+	if (base == NULL)
+		return;
+
+#if OS_HEAP_REGIONS
+	if (priv_region_free(base))
+		return;
+#endif
+
+	sys_lock();
+	{
+		priv_free(&Tlsf, priv_blk_head(base));
+	}
+	sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void *priv_walk_first( void )
+{
+	if (Tlsf.heap == NULL)
+		priv_blk_init(&Tlsf, Heap, sizeof(Heap));
+
+	return Tlsf.heap;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void *priv_walk_next( void *ptr, size_t *size, bool *vacant )
+{
+	blk_t *blk = ptr;
+
+	*size = priv_blk_size(blk);
+	*vacant = priv_blk_free(blk);
+
+	return *size ? priv_blk_next(blk) : NULL;
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#if OS_HEAP_SIZE && OS_HEAP_TLSF == 0
 
 static
 seg_t Heap[SEG_SIZE(OS_HEAP_SIZE)+1] =
@@ -85,6 +858,8 @@ void *sys_alloc( size_t size )
 		//	memory segment has been successfully allocated
 			break;
 		}
+
+		priv_stat_alloc(mem, size * sizeof(seg_t));
 	}
 	sys_unlock();
 
@@ -100,6 +875,11 @@ void sys_free( void *base )
 	seg_t *mem;
 	seg_t *seg = (seg_t *)base - 1;
 
+#if OS_HEAP_REGIONS
+	if (priv_region_free(base))
+		return;
+#endif
+
 	sys_lock();
 	{
 		for (mem = Heap; mem; mem = mem->next)
@@ -108,6 +888,9 @@ void sys_free( void *base )
 		//	this is not the memory segment we are looking for
 				continue;
 
+			if (mem->owner != mem)
+				priv_stat_free((size_t)(mem->next - mem) * sizeof(seg_t));
+
 			mem->owner = mem;
 		//	memory segment has been successfully released
 			break;
@@ -116,6 +899,127 @@ void sys_free( void *base )
 	sys_unlock();
 }
 
+/* -------------------------------------------------------------------------- */
+
+void *sys_realloc( void *base, size_t size )
+{
+	seg_t *seg = (seg_t *)base - 1;
+	void  *mem;
+
+	if (base == NULL)
+		return sys_alloc(size);
+
+	assert(size);
+
+#if OS_HEAP_REGIONS
+	if (priv_region(base) != NULL)
+		return priv_region_realloc(base, size);
+#endif
+
+	if (seg->next >= seg + SEG_SIZE(size) + 1)
+	//	memory segment is large enough
+		return base;
+
+	mem = sys_alloc(size);
+
+	if (mem)
+	{
+		memcpy(mem, base, (size_t)(seg->next - seg - 1) * sizeof(seg_t));
+		sys_free(base);
+	}
+
+	return mem;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void *priv_walk_first( void )
+{
+	return Heap;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void *priv_walk_next( void *ptr, size_t *size, bool *vacant )
+{
+	seg_t *seg = ptr;
+
+	*size = seg->next ? (size_t)(seg->next - seg) * sizeof(seg_t) : 0;
+	*vacant = seg->owner == seg;
+
+	return seg->next;
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#if OS_HEAP_SIZE
+
+#define WALK_RESTARTS 3 // maximum number of restarts of the heap walk
+
+unsigned sys_heapWalk( void )
+{
+	void    *blk = NULL;
+	unsigned gen = 0;
+	unsigned restarts = 0;
+	size_t   size;
+	size_t   run = 0, sum = 0, largest = 0, blocks = 0;
+	bool     vacant;
+	unsigned event = E_TIMEOUT;
+
+	while (event == E_TIMEOUT)
+	{
+		sys_lock();
+		{
+			if (blk != NULL && gen != Stat.gen && restarts++ == WALK_RESTARTS)
+		//	the heap is modified too often, the results of the previous walk are kept
+			{
+				event = E_FAILURE;
+			}
+			else
+			{
+				if (blk == NULL || gen != Stat.gen)
+			//	the heap has been modified, the walk must be restarted
+				{
+					blk = priv_walk_first();
+					gen = Stat.gen;
+					run = sum = largest = blocks = 0;
+				}
+
+				blk = priv_walk_next(blk, &size, &vacant);
+
+				if (vacant)
+			//	adjacent free memory segments are counted as one block
+					run += size;
+				else
+				if (run)
+				{
+					blocks++;
+					sum += run;
+					if (largest < run)
+						largest = run;
+					run = 0;
+				}
+
+				if (blk == NULL)
+			//	the walk has been completed
+				{
+					Stat.info.blocks  = blocks;
+					Stat.info.largest = largest;
+					Stat.info.frag    = sum ? 100U - (unsigned)((uint64_t)largest * 100U / sum) : 0;
+					event = E_SUCCESS;
+				}
+			}
+		}
+		sys_unlock();
+	}
+
+	return event;
+}
+
 #endif
 
 /* -------------------------------------------------------------------------- */
@@ -133,6 +1037,12 @@ void *sys_alloc( size_t size )
 	if (mem)
 		mem = memset(mem, 0, size);
 
+	sys_lock();
+	{
+		priv_stat_alloc(mem, 0);
+	}
+	sys_unlock();
+
 	assert(mem);
 
 	return mem;
@@ -142,9 +1052,120 @@ void *sys_alloc( size_t size )
 
 void sys_free( void *base )
 {
+	if (base == NULL)
+		return;
+
+#if OS_HEAP_REGIONS
+	if (priv_region_free(base))
+		return;
+#endif
+
 	free(base);
+
+	sys_lock();
+	{
+		priv_stat_free(0);
+	}
+	sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void *sys_realloc( void *base, size_t size )
+{
+	void *mem;
+
+	assert(size);
+
+#if OS_HEAP_REGIONS
+	if (base != NULL && priv_region(base) != NULL)
+		return priv_region_realloc(base, size);
+#endif
+
+	mem = realloc(base, size);
+
+	assert(mem);
+
+	return mem;
+}
+
+/* -------------------------------------------------------------------------- */
+
+unsigned sys_heapWalk( void )
+{
+	return E_FAILURE;
 }
 
 #endif
 
 /* -------------------------------------------------------------------------- */
+// SLAB CACHE SERVICES
+/* -------------------------------------------------------------------------- */
+
+void *core_slb_alloc( slb_t *slb, size_t size )
+{
+	void *mem = NULL;
+
+	if (slb != NULL)
+	{
+		assert(size <= slb->size);
+
+		sys_lock();
+		{
+			if (slb->free != NULL)
+			{
+				mem = slb->free;
+				slb->free = *(void **)mem;
+			}
+			else
+			if (slb->next < slb->end)
+			{
+				mem = slb->next;
+				slb->next += slb->size;
+			}
+		}
+		sys_unlock();
+
+		if (mem != NULL)
+			return memset(mem, 0, slb->size);
+	}
+
+	return sys_alloc(size);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void core_slb_free( slb_t *slb, void **res )
+{
+	void *tmp;
+
+	if (slb == NULL)
+	{
+		core_res_free(res);
+		return;
+	}
+
+	if (*res != NULL && *res != RELEASED)
+	{
+		core_obj_remove(res);
+		tmp = *res;
+		*res = RELEASED;
+
+		if ((char *)tmp >= slb->data && (char *)tmp < slb->end)
+	//	object has been taken from the slab
+		{
+			sys_lock();
+			{
+				*(void **)tmp = slb->free;
+				slb->free = tmp;
+			}
+			sys_unlock();
+		}
+		else
+		{
+			sys_free(tmp);
+		}
+	}
+}
+
+/* -------------------------------------------------------------------------- */
@@ -60,6 +60,28 @@ struct __seg
 	seg_t  * owner; // owner of memory block
 };
 
+/******************************************************************************
+ *
+ * Name              : heap statistics
+ *
+ ******************************************************************************/
+
+typedef struct __hsi hsi_t;
+
+struct __hsi
+{
+	size_t   size;     // size of the system heap (0 => heap provided by the compiler libraries)
+	size_t   used;     // number of bytes used by allocated memory segments (including headers)
+	size_t   max_used; // high-water mark of the used bytes
+	size_t   free;     // number of free bytes
+	unsigned allocs;   // number of successful allocations
+	unsigned frees;    // number of releases
+	unsigned failures; // number of failed allocations
+	size_t   blocks;   // number of free memory blocks (updated by sys_heapWalk)
+	size_t   largest;  // size of the largest free memory block (updated by sys_heapWalk)
+	unsigned frag;     // fragmentation index in percent, 0 => all free memory in one block (updated by sys_heapWalk)
+};
+
 /******************************************************************************
  *
  * Name              : sys_alloc
@@ -95,6 +117,131 @@ void *sys_alloc( size_t size );
 
 void sys_free( void *ptr );
 
+/******************************************************************************
+ *
+ * Name              : sys_regionAdd
+ *
+ * Description       : add memory region to the system heap
+ *
+ * Parameters
+ *   region          : region number (1 .. OS_HEAP_REGIONS)
+ *   base            : beginning of the memory region
+ *   size            : size of the memory region (in bytes)
+ *
+ * Return
+ *   E_SUCCESS       : memory region was successfully added
+ *   E_FAILURE       : invalid region number, region has already been added or is too small
+ *
+ * Note              : use only in thread mode
+ *                     region 0 is the system heap
+ *                     memory regions are managed by the TLSF allocator
+ *
+ ******************************************************************************/
+
+unsigned sys_regionAdd( unsigned region, void *base, size_t size );
+
+/******************************************************************************
+ *
+ * Name              : sys_allocIn
+ *
+ * Description       : system malloc procedure with clearing the allocated memory in the given memory region
+ *
+ * Parameters
+ *   region          : region number (0 => system heap, the same as sys_alloc)
+ *   size            : required size of the memory segment (in bytes)
+ *
+ * Return            : pointer to the beginning of allocated and cleared memory segment
+ *                     (memory segment is allocated on the system heap if the region is not available or exhausted)
+ *   0               : memory segment not allocated (not enough free memory)
+ *
+ * Note              : use only in thread mode
+ *                     memory segment is released with sys_free
+ *
+ ******************************************************************************/
+
+void *sys_allocIn( unsigned region, size_t size );
+
+/******************************************************************************
+ *
+ * Name              : sys_realloc
+ *
+ * Description       : system realloc procedure
+ *
+ * Parameters
+ *   ptr             : pointer to a memory segment previously allocated with sys_alloc or sys_realloc functions
+ *                     NULL => allocate a new memory segment, the same as sys_alloc
+ *   size            : required size of the memory segment (in bytes)
+ *
+ * Return            : pointer to the beginning of reallocated memory segment
+ *                     (content of the memory segment is preserved up to the lesser of the old and new sizes)
+ *   0               : memory segment not reallocated (not enough free memory), the previous memory segment is left untouched
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+void *sys_realloc( void *ptr, size_t size );
+
+/******************************************************************************
+ *
+ * Name              : sys_alignedAlloc
+ *
+ * Description       : system malloc procedure with clearing and aligning the allocated memory
+ *
+ * Parameters
+ *   align           : required alignment of the memory segment (in bytes, power of two)
+ *   size            : required size of the memory segment (in bytes)
+ *
+ * Return            : pointer to the beginning of allocated, cleared and aligned memory segment
+ *   0               : memory segment not allocated (not enough free memory)
+ *
+ * Note              : use only in thread mode
+ *                     available only with the TLSF system heap (OS_HEAP_SIZE > 0 and OS_HEAP_TLSF > 0)
+ *
+ ******************************************************************************/
+
+#if OS_HEAP_SIZE && OS_HEAP_TLSF
+void *sys_alignedAlloc( size_t align, size_t size );
+#endif
+
+/******************************************************************************
+ *
+ * Name              : sys_heapInfo
+ *
+ * Description       : get statistics of the system heap
+ *                     (size, used and free bytes, high-water mark and allocation counters are maintained with every alloc / free,
+ *                      number of free blocks, largest free block and fragmentation index are results of the last sys_heapWalk)
+ *
+ * Parameters
+ *   info            : pointer to the heap statistics structure
+ *
+ * Return            : none
+ *
+ ******************************************************************************/
+
+void sys_heapInfo( hsi_t *info );
+
+/******************************************************************************
+ *
+ * Name              : sys_heapWalk
+ *
+ * Description       : walk through the system heap and update number of free blocks, largest free block and fragmentation index,
+ *                     critical section is entered separately for every memory block and the walk is restarted if the heap has been modified
+ *
+ * Parameters        : none
+ *
+ * Return
+ *   E_SUCCESS       : heap statistics were successfully updated
+ *   E_FAILURE       : heap has been modified during every walk and the walk was given up after a few restarts
+ *                     or the heap is provided by the compiler libraries, results of the previous walk are kept
+ *
+ * Note              : use only in thread mode
+ *                     with OS_HEAP_WALK the heap is walked by the idle task
+ *
+ ******************************************************************************/
+
+unsigned sys_heapWalk( void );
+
 /******************************************************************************
  *
  * Name              : core_res_free
@@ -117,12 +264,96 @@ void core_res_free( void **res )
 
 	if (*res != NULL && *res != RELEASED)
 	{
+		core_obj_remove(res);
 		tmp = *res;
 		*res = RELEASED;
 		sys_free(tmp);
 	}
 }
 
+/******************************************************************************
+ *
+ * Name              : slab cache
+ *
+ * Note              : for internal use
+ *
+ ******************************************************************************/
+
+// slab cache of objects of the same size
+// objects are taken from the free list or from the untouched part of the slab,
+// when the slab is exhausted objects are allocated on the system heap
+
+typedef struct __slb slb_t;
+
+struct __slb
+{
+	void   * free;  // list of released objects (linked through the first word of the object)
+	char   * next;  // first untouched object of the slab
+	char   * data;  // beginning of the slab
+	char   * end;   // end of the slab
+	size_t   size;  // size of the object
+};
+
+#define               _SLB_INIT( _data ) { NULL, (char *)(_data), (char *)(_data), (char *)(_data) + sizeof(_data), sizeof(*(_data)) }
+
+/******************************************************************************
+ *
+ * Name              : OS_SLB
+ *
+ * Description       : define and initialize static slab cache of objects
+ *
+ * Parameters
+ *   slb             : name of the slab cache
+ *   type            : type of the object
+ *   count           : number of objects in the slab
+ *
+ * Note              : for internal use
+ *
+ ******************************************************************************/
+
+#define             OS_SLB( slb, type, count )                      \
+                       static type  slb##__data[count];              \
+                       static slb_t slb[1] = { _SLB_INIT(slb##__data) }
+
+/******************************************************************************
+ *
+ * Name              : core_slb_alloc
+ *
+ * Description       : allocate and clear an object from the slab cache or the system heap
+ *
+ * Parameters
+ *   slb             : pointer to the slab cache
+ *                     NULL => object is allocated on the system heap
+ *   size            : size of the object (in bytes)
+ *
+ * Return            : pointer to the allocated and cleared object
+ *   0               : object not allocated (not enough free memory)
+ *
+ * Note              : for internal use
+ *
+ ******************************************************************************/
+
+void *core_slb_alloc( slb_t *slb, size_t size );
+
+/******************************************************************************
+ *
+ * Name              : core_slb_free
+ *
+ * Description       : frees given resources, objects from the slab are returned to the slab cache
+ *
+ * Parameters
+ *   slb             : pointer to the slab cache
+ *                     NULL => the same as core_res_free
+ *   res             : pointer to a pointer to a resources
+ *
+ * Return            : none
+ *
+ * Note              : for internal use
+ *
+ ******************************************************************************/
+
+void core_slb_free( slb_t *slb, void **res );
+
 #ifdef __cplusplus
 }
 #endif
@@ -56,6 +56,146 @@ extern "C" {
 
 /* -------------------------------------------------------------------------- */
 
+#ifndef OS_PRIO_LEVELS
+#define OS_PRIO_LEVELS    0
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_TIMER_WHEEL
+#define OS_TIMER_WHEEL    0
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_TIMER_DAEMON
+#define OS_TIMER_DAEMON   0
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_QUEUE_BUCKETS
+#define OS_QUEUE_BUCKETS  0
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_HEAP_TLSF
+#define OS_HEAP_TLSF      0
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_HEAP_WALK
+#define OS_HEAP_WALK      0
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_HEAP_REGIONS
+#define OS_HEAP_REGIONS   0
+#endif
+
+#ifndef OS_REGION_TSK
+#define OS_REGION_TSK     1
+#endif
+
+#ifndef OS_REGION_BUF
+#define OS_REGION_BUF     0
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_SLAB_BAR
+#define OS_SLAB_BAR       0
+#endif
+#ifndef OS_SLAB_CND
+#define OS_SLAB_CND       0
+#endif
+#ifndef OS_SLAB_EVT
+#define OS_SLAB_EVT       0
+#endif
+#ifndef OS_SLAB_FLG
+#define OS_SLAB_FLG       0
+#endif
+#ifndef OS_SLAB_LST
+#define OS_SLAB_LST       0
+#endif
+#ifndef OS_SLAB_MTX
+#define OS_SLAB_MTX       0
+#endif
+#ifndef OS_SLAB_MUT
+#define OS_SLAB_MUT       0
+#endif
+#ifndef OS_SLAB_SEM
+#define OS_SLAB_SEM       0
+#endif
+#ifndef OS_SLAB_SIG
+#define OS_SLAB_SIG       0
+#endif
+#ifndef OS_SLAB_TMR
+#define OS_SLAB_TMR       0
+#endif
+#ifndef OS_SLAB_TSK
+#define OS_SLAB_TSK       0
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_TASK_STATS
+#define OS_TASK_STATS     0
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_TRACE_SIZE
+#define OS_TRACE_SIZE     0
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_LOCK_PROFILE
+#define OS_LOCK_PROFILE   0
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_OBJECT_STATS
+#define OS_OBJECT_STATS   0
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_STACK_SCAN
+#define OS_STACK_SCAN     0
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_STACK_SHARED
+#define OS_STACK_SHARED   0
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_TASK_PROXY
+#define OS_TASK_PROXY     0
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_INPLACE_FUNCTION
+#define OS_INPLACE_FUNCTION 0
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_RING_POW2
+#define OS_RING_POW2      0
+#endif
+
+/* -------------------------------------------------------------------------- */
+
 #if     OS_TIMER_SIZE == 16
 typedef uint16_t     cnt_t;
 #define CNT_MAX          0xFFFFU
@@ -71,6 +211,24 @@ typedef uint64_t     cnt_t;
 
 /* -------------------------------------------------------------------------- */
 
+// cycle counter of the task statistics, the object statistics, the kernel trace, the critical section profiler and the timer daemon
+// port counter (port_cyc_time) => PORT_CYC_FREQUENCY
+// Cortex-M3 and higher         => DWT->CYCCNT, CPU_FREQUENCY
+// otherwise                    => system timer counter, OS_FREQUENCY
+
+#if     defined(PORT_CYC_FREQUENCY)
+typedef uint64_t     cyc_t;
+#define CYC_FREQUENCY    (PORT_CYC_FREQUENCY)
+#elif   defined(DWT_CTRL_CYCCNTENA_Msk) && defined(CPU_FREQUENCY)
+typedef uint32_t     cyc_t;
+#define CYC_FREQUENCY    (CPU_FREQUENCY)
+#else
+typedef cnt_t        cyc_t;
+#define CYC_FREQUENCY    (OS_FREQUENCY)
+#endif
+
+/* -------------------------------------------------------------------------- */
+
 #if     HW_TIMER_SIZE > OS_TIMER_SIZE
 #error  HW_TIMER_SIZE > OS_TIMER_SIZE causes unexpected problems!
 #endif
@@ -106,24 +264,108 @@ typedef enum __tid
 
 /* -------------------------------------------------------------------------- */
 
+#if OS_QUEUE_BUCKETS
+
+// buckets of the BLOCKED queue
+// tasks are queued by bucket (priority, limited to size - 1) and in the FIFO order inside the bucket
+// size == 1 => strict FIFO queue
+// buckets are assigned only statically with the '_XXX_INIT_BKT' initializers, there is no function to change them at run time;
+// objects initialized with 'xxx_init' or created with 'xxx_create' functions always have BLOCKED queues sorted by priority
+
+typedef struct __bkt
+{
+	uint32_t map;   // non-empty buckets
+	unsigned size;  // number of buckets (1 .. 32)
+	tsk_t ***tail;  // pointers to the link fields of the last tasks in the buckets
+
+}	bkt_t;
+
+#define               _BKT_INIT( _size, _tail ) { 0, _size, _tail }
+
+#ifndef __cplusplus
+#define               _BKT_DATA( _size ) (tsk_t **[_size]){ NULL }
+#endif
+
+#endif//OS_QUEUE_BUCKETS
+
+/* -------------------------------------------------------------------------- */
+
+// object statistics
+
+typedef struct __ost
+{
+	unsigned takes;    // number of take / wait requests
+	unsigned gives;    // number of give / send requests
+	unsigned waits;    // number of blocking waits
+	unsigned timeouts; // number of blocking waits finished with timeout
+	uint64_t time;     // total time of the blocking waits (in cycles of frequency CYC_FREQUENCY)
+	cyc_t    max;      // longest blocking wait (in cycles)
+	unsigned waiters;  // current number of tasks in the BLOCKED queue
+	unsigned depth;    // max number of tasks in the BLOCKED queue
+	unsigned peak;     // max filling level (value of semaphore, number of items in queue, number of bytes in stream / message buffer)
+
+}	ost_t;
+
+#if OS_OBJECT_STATS
+#define               _OST_INIT() , { 0, 0, 0, 0, 0, 0, 0, 0, 0 }
+#else
+#define               _OST_INIT()
+#endif
+
+/* -------------------------------------------------------------------------- */
+
 // object header
+// every BLOCKED queue is the first field of the object header
 
 typedef struct __obj
 {
 	tsk_t  * queue; // next process in the BLOCKED queue
 	void   * res;   // allocated object's resource
+#if OS_QUEUE_BUCKETS
+	bkt_t  * bkt;   // buckets of the BLOCKED queue; NULL => BLOCKED queue sorted by priority
+#endif
+#if OS_OBJECT_STATS
+	ost_t    stat;  // object statistics
+#endif
 
 }	obj_t;
 
-#define               _OBJ_INIT() { NULL, NULL }
+#if OS_QUEUE_BUCKETS
+#define               _OBJ_INIT() { NULL, NULL, NULL _OST_INIT() }
+#define               _OBJ_INIT_BKT( _bkt ) { NULL, NULL, _bkt _OST_INIT() }
+#else
+#define               _OBJ_INIT() { NULL, NULL _OST_INIT() }
+#endif
 
 /* -------------------------------------------------------------------------- */
 
+// BLOCKED queue outside of the objects (queues of sleeping tasks, of tasks waiting for destruction or termination)
+// the kernel reaches the object header through the BLOCKED queue only for the buckets and the statistics
+
+#if OS_QUEUE_BUCKETS || OS_OBJECT_STATS
+typedef obj_t blq_t;
+#define               _BLQ_INIT() _OBJ_INIT()
+#else
+typedef struct __blq
+{
+	tsk_t  * queue; // next process in the BLOCKED queue
+
+}	blq_t;
+#define               _BLQ_INIT() { NULL }
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+// remove the object from the table of objects with statistics (the object is initialized again)
+#if OS_OBJECT_STATS
+void core_obj_init( obj_t *obj );
+#else
 __STATIC_INLINE
 void core_obj_init( obj_t *obj )
 {
 	(void) obj;
 }
+#endif
 
 /* -------------------------------------------------------------------------- */
 
@@ -142,6 +384,30 @@ typedef struct __hdr
 
 /* -------------------------------------------------------------------------- */
 
+// buffer span (range of the ring buffer)
+// zero-copy access to the data of the stream / message buffer
+// the span is divided into two contiguous parts when it wraps around the end of the buffer
+
+typedef struct __rng
+{
+	char   * data[2]; // beginnings of the parts of the span
+	unsigned size[2]; // sizes of the parts of the span; size[1] == 0 => the span is contiguous
+
+}	rng_t;
+
+// mask of the ring buffer of size '_limit' (positions are wrapped with the mask when OS_RING_POW2 > 0)
+// 0 => size of the ring buffer is not a power of two, positions are wrapped with comparison
+
+#define               _RNG_MASK( _limit ) ( ((_limit) > 1U && ((_limit) & ((_limit) - 1U)) == 0) ? (_limit) - 1U : 0U )
+
+#if OS_RING_POW2
+#define               _RNG_INIT( _limit ) , _RNG_MASK(_limit)
+#else
+#define               _RNG_INIT( _limit )
+#endif
+
+/* -------------------------------------------------------------------------- */
+
 __STATIC_INLINE
 void core_hdr_init( hdr_t *hdr )
 {
@@ -162,8 +428,19 @@ typedef struct __sys
 	cnt_t    cnt;   // system timer counter
 #endif
 	tsk_t  * sig;   // queue of tasks waiting for a signal
-	tsk_t  * dly;   // queue of sleeping and suspended tasks
-	tsk_t  * des;   // queue of tasks waiting for destruction
+	blq_t    dly;   // queue of sleeping and suspended tasks
+	blq_t    des;   // queue of tasks waiting for destruction
+#if OS_TIMER_DAEMON
+	tmr_t  * tmr;   // queue of timers with pending callbacks (for the timer daemon)
+	tmr_t  * dmn;   // timer whose callback procedure is executed by the timer daemon
+#endif
+#if OS_TASK_STATS
+	struct {
+	unsigned switches; // number of context switches
+	unsigned wakeups;  // number of task wakeups
+	unsigned timers;   // number of timer expirations
+	}        stat;
+#endif
 
 }	sys_t;
 
@@ -33,6 +33,7 @@
 #include "inc/ostimer.h"
 #include "inc/ostask.h"
 #include "inc/osmutex.h"
+#include "inc/oscriticalsection.h"
 
 /* -------------------------------------------------------------------------- */
 // SYSTEM INTERNAL SERVICES
@@ -42,8 +43,10 @@ static
 void priv_ctx_switchNow( void )
 {
 	port_ctx_switch();
+	core_cri_leave();
 	port_clr_lock(); __ISB();
 	port_set_lock();
+	core_cri_enter();
 }
 
 /* -------------------------------------------------------------------------- */
@@ -71,6 +74,44 @@ void priv_rdy_remove( hdr_t *hdr )
 	prv->next = nxt;
 }
 
+/* -------------------------------------------------------------------------- */
+
+#if OS_PRIO_LEVELS || OS_TIMER_WHEEL || OS_QUEUE_BUCKETS
+
+static
+unsigned priv_bit_msb( uint32_t map )
+{
+#if defined(__GNUC__) && (UINT_MAX == 0xFFFFFFFFU)
+	return 31U - (unsigned)__builtin_clz(map);
+#elif defined(__CORTEX_M) && (__CORTEX_M >= 3)
+	return 31U - (unsigned)__CLZ(map);
+#else
+	unsigned bit = 0;
+	if (map & 0xFFFF0000UL) { map >>= 16; bit += 16; }
+	if (map & 0x0000FF00UL) { map >>=  8; bit +=  8; }
+	if (map & 0x000000F0UL) { map >>=  4; bit +=  4; }
+	if (map & 0x0000000CUL) { map >>=  2; bit +=  2; }
+	if (map & 0x00000002UL) {             bit +=  1; }
+	return bit;
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#if OS_TIMER_WHEEL || OS_QUEUE_BUCKETS
+
+static
+unsigned priv_bit_lsb( uint32_t map )
+{
+	return priv_bit_msb(map & (~map + 1));
+}
+
+#endif
+
 /* -------------------------------------------------------------------------- */
 // SYSTEM TIMER SERVICES
 /* -------------------------------------------------------------------------- */
@@ -79,6 +120,8 @@ tmr_t WAIT = { .hdr={ .prev=&WAIT, .next=&WAIT, .id=ID_TIMER }, .delay=INFINITE
 
 /* -------------------------------------------------------------------------- */
 
+#if OS_TIMER_WHEEL == 0
+
 static
 void priv_tmr_insert( tmr_t *tmr )
 {
@@ -103,6 +146,286 @@ void priv_tmr_remove( tmr_t *tmr )
 
 /* -------------------------------------------------------------------------- */
 
+tmr_t *core_tmr_next( tmr_t *tmr )
+{
+	return tmr->hdr.next;
+}
+
+/* -------------------------------------------------------------------------- */
+
+#else //OS_TIMER_WHEEL
+
+#if     OS_TIMER_WHEEL == 2
+#define WHL_BITS              1
+#elif   OS_TIMER_WHEEL == 4
+#define WHL_BITS              2
+#elif   OS_TIMER_WHEEL == 8
+#define WHL_BITS              3
+#elif   OS_TIMER_WHEEL == 16
+#define WHL_BITS              4
+#elif   OS_TIMER_WHEEL == 32
+#define WHL_BITS              5
+#else
+#error  osconfig.h: Incorrect OS_TIMER_WHEEL value! Must be 0, 2, 4, 8, 16 or 32.
+#endif
+
+#define WHL_SIZE            (OS_TIMER_WHEEL)
+#define WHL_LEVELS        (((OS_TIMER_SIZE)+(WHL_BITS)-1)/(WHL_BITS))
+#define WHL_SLOT(time,lvl)  ((unsigned)((time)>>((lvl)*(WHL_BITS)))&((WHL_SIZE)-1))
+
+#if     WHL_LEVELS > 32
+#error  osconfig.h: Incorrect OS_TIMER_WHEEL value! Too many levels of the wheel!
+#endif
+
+// timers counting down are kept in the slots of the hierarchical wheel;
+// the level of the slot is the most significant digit in which the expiration time
+// of the timer differs from the time of the wheel, the slot is the value of this digit;
+// the slots are moved to lower levels as the wheel time reaches them,
+// the wheel is moved only by the timer handler, a new timer is inserted relative to the time of the wheel
+// without moving it (the time of the wheel is set to the current time only when the wheel is empty),
+// expired timers are moved to the WAIT queue and served there in the FIFO order;
+// timers counting indefinitely are kept in the separate queue
+
+static  hdr_t    WheelSlot[WHL_LEVELS][WHL_SIZE]; // slots of the wheel
+static  uint32_t WheelMap[WHL_LEVELS];            // non-empty slots of each level
+static  uint32_t WheelGrp;                        // non-empty levels
+static  hdr_t    WheelInf = { .prev=&WheelInf, .next=&WheelInf }; // timers counting indefinitely
+static  cnt_t    WheelTime;                       // time of the wheel
+static  cnt_t    WheelNext;                       // time of the next event of the wheel
+
+/* -------------------------------------------------------------------------- */
+// return the level of the wheel for the timer expiring at the time 'time'
+
+static
+unsigned priv_whl_level( cnt_t time )
+{
+	time ^= WheelTime;
+#if OS_TIMER_SIZE == 64
+	if (time >> 32)
+		return (priv_bit_msb((uint32_t)(time >> 32)) + 32) / (WHL_BITS);
+#endif
+	return priv_bit_msb((uint32_t)time) / (WHL_BITS);
+}
+
+/* -------------------------------------------------------------------------- */
+// return the time when the wheel reaches the slot
+
+static
+cnt_t priv_whl_time( unsigned lvl, unsigned idx )
+{
+	unsigned sft  = (lvl + 1) * (WHL_BITS);
+	cnt_t    time = (cnt_t)idx << (lvl * (WHL_BITS));
+
+	if (sft < OS_TIMER_SIZE)
+	{
+		time |= (cnt_t)(WheelTime >> sft) << sft;
+		if (idx <= WHL_SLOT(WheelTime, lvl))
+			time += (cnt_t)1 << sft;
+	}
+
+	return time;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_whl_clear( unsigned lvl, unsigned idx )
+{
+	if ((WheelMap[lvl] &= ~(1UL << idx)) == 0)
+		WheelGrp &= ~(1UL << lvl);
+}
+
+/* -------------------------------------------------------------------------- */
+// insert the timer into the slot of the wheel; the timer expired at the time 'now' is moved to the WAIT queue
+
+static
+void priv_whl_insert( tmr_t *tmr, cnt_t now )
+{
+	hdr_t  * nxt = &WAIT.hdr;
+	cnt_t    time;
+	unsigned lvl, idx;
+
+	if (tmr->delay == INFINITE)
+	{
+		nxt = &WheelInf;
+	}
+	else
+	if (tmr->delay > (cnt_t)(now - tmr->start)) // timer still counts
+	{
+		if (WheelGrp == 0)
+			WheelNext = (WheelTime = now) - 1;
+
+		time = tmr->start + tmr->delay;
+		lvl  = priv_whl_level(time);
+		idx  = WHL_SLOT(time, lvl);
+		nxt  = &WheelSlot[lvl][idx];
+
+		if ((WheelMap[lvl] & (1UL << idx)) == 0)
+		{
+			nxt->prev = nxt->next = nxt;
+			WheelMap[lvl] |= 1UL << idx;
+			WheelGrp |= 1UL << lvl;
+
+			time = priv_whl_time(lvl, idx);
+			if ((cnt_t)(time - WheelTime) < (cnt_t)(WheelNext - WheelTime))
+				WheelNext = time;
+		}
+	}
+
+	priv_rdy_insert(&tmr->hdr, nxt);
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_whl_remove( tmr_t *tmr )
+{
+	uintptr_t pos = (uintptr_t)tmr->hdr.next - (uintptr_t)WheelSlot;
+
+	priv_rdy_remove(&tmr->hdr);
+
+	if (tmr->hdr.next == tmr->hdr.prev && pos < sizeof(WheelSlot)) // the slot is empty
+	{
+		pos /= sizeof(hdr_t);
+		priv_whl_clear(pos / (WHL_SIZE), pos % (WHL_SIZE));
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+// find the time of the next event of the wheel
+
+static
+void priv_whl_next( void )
+{
+	uint32_t grp = WheelGrp;
+	uint32_t map;
+	unsigned lvl, idx;
+	cnt_t    time;
+
+	WheelNext = WheelTime - 1;
+
+	while (grp)
+	{
+		lvl  = priv_bit_lsb(grp);
+		grp &= grp - 1;
+		map  = WheelMap[lvl];
+		idx  = WHL_SLOT(WheelTime, lvl);
+		map &= ~((2UL << idx) - 1);
+		idx  = priv_bit_lsb(map ? map : WheelMap[lvl]);
+		time = priv_whl_time(lvl, idx);
+		if ((cnt_t)(time - WheelTime) < (cnt_t)(WheelNext - WheelTime))
+			WheelNext = time;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+// insert again all timers from the slot
+
+static
+void priv_whl_cascade( unsigned lvl, unsigned idx )
+{
+	hdr_t *slot = &WheelSlot[lvl][idx];
+	hdr_t  lst;
+	tmr_t *tmr;
+
+	if ((WheelMap[lvl] & (1UL << idx)) == 0)
+		return;
+
+	priv_whl_clear(lvl, idx);
+
+	lst.next = slot->next; ((hdr_t *)lst.next)->prev = &lst;
+	lst.prev = slot->prev; ((hdr_t *)lst.prev)->next = &lst;
+
+	while (tmr = lst.next, tmr != (tmr_t *)&lst)
+	{
+		priv_rdy_remove(&tmr->hdr);
+		priv_whl_insert(tmr, WheelTime);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+// move the wheel to the time 'now'; expired timers are moved to the WAIT queue
+
+static
+void priv_whl_advance( cnt_t now )
+{
+	cnt_t    time;
+	unsigned lvl;
+
+	while (WheelGrp && (cnt_t)(WheelNext - WheelTime) <= (cnt_t)(now - WheelTime))
+	{
+		WheelTime = time = WheelNext;
+
+		for (lvl = WHL_LEVELS - 1; lvl > 0; lvl--)
+			if ((time & (((cnt_t)1 << (lvl * (WHL_BITS))) - 1)) == 0)
+				priv_whl_cascade(lvl, WHL_SLOT(time, lvl));
+		priv_whl_cascade(0, WHL_SLOT(time, 0));
+
+		priv_whl_next();
+	}
+
+	WheelTime = now;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_tmr_insert( tmr_t *tmr )
+{
+	tmr->hdr.id = ID_TIMER;
+	priv_whl_insert(tmr, core_sys_time());
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_tmr_remove( tmr_t *tmr )
+{
+	tmr->hdr.id = ID_STOPPED;
+	priv_whl_remove(tmr);
+}
+
+/* -------------------------------------------------------------------------- */
+
+tmr_t *core_tmr_next( tmr_t *tmr )
+{
+	hdr_t  * hdr = tmr->hdr.next;
+	uintptr_t pos = (uintptr_t)hdr - (uintptr_t)WheelSlot;
+
+	if (hdr == &WAIT.hdr)
+	{
+		if (WheelInf.next != &WheelInf)
+			return WheelInf.next;
+		pos = 0;
+	}
+	else
+	if (hdr == &WheelInf)
+	{
+		pos = 0;
+	}
+	else
+	if (pos < sizeof(WheelSlot))
+	{
+		pos = pos / sizeof(hdr_t) + 1;
+	}
+	else
+	{
+		return (tmr_t *)hdr;
+	}
+
+	for (; pos < (WHL_LEVELS) * (WHL_SIZE); pos++)
+		if (WheelMap[pos / (WHL_SIZE)] & (1UL << (pos % (WHL_SIZE))))
+			return WheelSlot[pos / (WHL_SIZE)][pos % (WHL_SIZE)].next;
+
+	return &WAIT;
+}
+
+/* -------------------------------------------------------------------------- */
+
+#endif//OS_TIMER_WHEEL
+
+/* -------------------------------------------------------------------------- */
+
 void core_tmr_insert( tmr_t *tmr )
 {
 	priv_tmr_insert(tmr);
@@ -118,6 +441,8 @@ void core_tmr_remove( tmr_t *tmr )
 
 /* -------------------------------------------------------------------------- */
 
+#if OS_TIMER_WHEEL == 0
+
 #if HW_TIMER_SIZE
 
 static
@@ -158,9 +483,168 @@ bool priv_tmr_expired( tmr_t *tmr )
 
 /* -------------------------------------------------------------------------- */
 
+#else //OS_TIMER_WHEEL
+
+#if HW_TIMER_SIZE
+
+static
+bool priv_whl_expired( void )
+{
+	port_tmr_stop();
+
+	if (WheelGrp == 0)
+	return false; // return if the wheel is empty
+
+	if ((cnt_t)(WheelNext - WheelTime) <= (cnt_t)(core_sys_time() - WheelTime))
+	return true;  // return if the wheel reached the next event
+
+	port_tmr_start(WheelNext);
+
+	if ((cnt_t)(WheelNext - WheelTime) >  (cnt_t)(core_sys_time() - WheelTime))
+	return false; // return if the next event is still pending
+
+	port_tmr_stop();
+
+	return true;  // however the wheel reached the next event
+}
+
+/* -------------------------------------------------------------------------- */
+
+#else
+
+static
+bool priv_whl_expired( void )
+{
+	return false; // the wheel is moved with every tick of the system timer
+}
+
+#endif
+
+#endif//OS_TIMER_WHEEL
+
+/* -------------------------------------------------------------------------- */
+
+#if OS_TIMER_DAEMON
+
+#if     OS_PRIO_LEVELS && OS_TIMER_DAEMON >= OS_PRIO_LEVELS
+#error  osconfig.h: Incorrect OS_TIMER_DAEMON value! Must be less than OS_PRIO_LEVELS.
+#endif
+
+static  void     priv_dmn_handler( void );
+static  stk_t    DAEMON_STK[STK_SIZE(OS_STACK_SIZE)];
+static  tsk_t    DAEMON = { .state=priv_dmn_handler, .stack=DAEMON_STK, .size=sizeof(DAEMON_STK), .basic=OS_TIMER_DAEMON, .prio=OS_TIMER_DAEMON }; // timer daemon
+static  tmr_t ** DaemonTail = &System.tmr; // last link in the queue of the timer daemon
+
+/* -------------------------------------------------------------------------- */
+
+// queue the pending callback of timer 'tmr' and wake up the timer daemon
+
+static
+void priv_dmn_insert( tmr_t *tmr )
+{
+	if (tmr->dmn.back == NULL)
+	{
+		tmr->dmn.stamp = core_cyc_time();
+		tmr->dmn.next = NULL;
+		tmr->dmn.back = DaemonTail;
+		*DaemonTail = tmr;
+		DaemonTail = &tmr->dmn.next;
+	}
+
+	if (DAEMON.hdr.id == ID_STOPPED)
+	{
+		core_ctx_init(&DAEMON);
+		core_tsk_insert(&DAEMON);
+	}
+	else
+	if (DAEMON.guard == &System.dly.queue)
+	{
+		core_tsk_wakeup(&DAEMON, E_SUCCESS);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+// remove the pending callback of timer 'tmr' from the queue of the timer daemon
+
+static
+void priv_dmn_remove( tmr_t *tmr )
+{
+	tmr_t *nxt = tmr->dmn.next;
+
+	if (nxt)
+		nxt->dmn.back = tmr->dmn.back;
+	else
+		DaemonTail = tmr->dmn.back;
+
+	*tmr->dmn.back = nxt;
+	tmr->dmn.back = NULL;
+}
+
+/* -------------------------------------------------------------------------- */
+
+// the pending callback is removed from the queue before it is executed, so the timer can expire again meanwhile
+// System.dmn points to the timer while its callback procedure is executed (tmr_thisISR)
+// and is cleared when the timer is reset or deleted by the callback procedure
+
+static
+void priv_dmn_handler( void )
+{
+	tmr_t *tmr;
+	fun_t *fun;
+	cyc_t  now;
+
+	port_set_lock();
+	core_cri_enter();
+	while (tmr = System.tmr, tmr == NULL)
+		core_tsk_suspend(&DAEMON);
+	priv_dmn_remove(tmr);
+	System.dmn = tmr;
+	fun = tmr->state;
+	now = core_cyc_time();
+	if (tmr->dmn.lag < (cyc_t)(now - tmr->dmn.stamp))
+		tmr->dmn.lag = (cyc_t)(now - tmr->dmn.stamp);
+	core_cri_leave();
+	port_clr_lock();
+
+	if (fun)
+		fun();
+
+	port_set_lock();
+	core_cri_enter();
+	now = core_cyc_time() - now;
+	if (System.dmn)
+	{
+		if (tmr->dmn.run < now)
+			tmr->dmn.run = now;
+		System.dmn = NULL;
+	}
+	core_cri_leave();
+	port_clr_lock();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void core_tmr_cancel( tmr_t *tmr )
+{
+	if (tmr->dmn.back)
+		priv_dmn_remove(tmr);
+	if (System.dmn == tmr)
+		System.dmn = NULL;
+}
+
+#endif//OS_TIMER_DAEMON
+
+/* -------------------------------------------------------------------------- */
+
 static
 void priv_tmr_wakeup( tmr_t *tmr, unsigned event )
 {
+#if OS_TIMER_DAEMON
+	if (tmr->dmn.mode == tmrDaemon)
+		priv_dmn_insert(tmr);
+	else
+#endif
 	if (tmr->state)
 		tmr->state();
 
@@ -173,31 +657,75 @@ void priv_tmr_wakeup( tmr_t *tmr, unsigned event )
 
 /* -------------------------------------------------------------------------- */
 
+static
+void priv_tmr_timeout( tmr_t *tmr )
+{
+	tmr->start += tmr->delay;
+
+	if (tmr->hdr.id == ID_TIMER)
+	{
+#if OS_TASK_STATS
+		System.stat.timers++;
+#endif
+		core_trc_put(TRC_TIMER, tmr, 0, 0);
+		tmr->delay = tmr->period;
+		priv_tmr_wakeup(tmr, E_SUCCESS);
+	}
+	else  /* hdr.id == ID_READY */
+	{
+		tmr->delay = 0;
+		core_tsk_wakeup((tsk_t *)tmr, E_TIMEOUT);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+#if OS_TIMER_WHEEL == 0
+
 void core_tmr_handler( void )
 {
 	tmr_t *tmr;
 
 	port_set_lock();
+	core_cri_enter();
 	{
+		core_trc_put(TRC_TICK, NULL, 0, 0);
+
 		while (priv_tmr_expired(tmr = WAIT.hdr.next))
+			priv_tmr_timeout(tmr);
+	}
+	core_cri_leave();
+	port_clr_lock();
+}
+
+/* -------------------------------------------------------------------------- */
+
+#else //OS_TIMER_WHEEL
+
+void core_tmr_handler( void )
+{
+	tmr_t *tmr;
+
+	port_set_lock();
+	core_cri_enter();
+	{
+		core_trc_put(TRC_TICK, NULL, 0, 0);
+
+		do
 		{
-			tmr->start += tmr->delay;
+			priv_whl_advance(core_sys_time());
 
-			if (tmr->hdr.id == ID_TIMER)
-			{
-				tmr->delay = tmr->period;
-				priv_tmr_wakeup(tmr, E_SUCCESS);
-			}
-			else  /* hdr.id == ID_READY */
-			{
-				tmr->delay = 0;
-				core_tsk_wakeup((tsk_t *)tmr, E_TIMEOUT);
-			}
+			while (tmr = WAIT.hdr.next, tmr != &WAIT)
+				priv_tmr_timeout(tmr);
 		}
+		while (priv_whl_expired());
 	}
+	core_cri_leave();
 	port_clr_lock();
 }
 
+#endif//OS_TIMER_WHEEL
+
 /* -------------------------------------------------------------------------- */
 // SYSTEM TASK SERVICES
 /* -------------------------------------------------------------------------- */
@@ -219,6 +747,8 @@ sys_t System = { .cur=&MAIN };
 
 /* -------------------------------------------------------------------------- */
 
+#if OS_PRIO_LEVELS == 0
+
 static
 void priv_tsk_insert( tsk_t *tsk )
 {
@@ -230,48 +760,271 @@ void priv_tsk_insert( tsk_t *tsk )
 		do nxt = nxt->hdr.next;
 		while (tsk->prio <= nxt->prio);
 
-	priv_rdy_insert(&tsk->hdr, &nxt->hdr);
+	priv_rdy_insert(&tsk->hdr, &nxt->hdr);
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_tsk_remove( tsk_t *tsk )
+{
+	priv_rdy_remove(&tsk->hdr);
+}
+
+/* -------------------------------------------------------------------------- */
+
+#else //OS_PRIO_LEVELS
+
+#if     OS_PRIO_LEVELS > 1024
+#error  osconfig.h: Incorrect OS_PRIO_LEVELS value! Must be less than or equal to 1024.
+#endif
+
+#if     OS_MAIN_PRIO >= OS_PRIO_LEVELS
+#error  osconfig.h: Incorrect OS_MAIN_PRIO value! Must be less than OS_PRIO_LEVELS.
+#endif
+
+// the tasks' queue is still sorted by priority, but every priority level
+// has its own entry point and the non-empty levels are marked in the bitmap
+
+static  tsk_t  * ReadyHead[OS_PRIO_LEVELS]          = { [OS_MAIN_PRIO]    = &MAIN };                    // first task of the priority level
+static  uint32_t ReadyMap[((OS_PRIO_LEVELS)+31)/32] = { [OS_MAIN_PRIO/32] = 1UL << (OS_MAIN_PRIO%32) }; // non-empty priority levels
+static  uint32_t ReadyGrp                           =                       1UL << (OS_MAIN_PRIO/32);   // non-empty words of ReadyMap
+
+/* -------------------------------------------------------------------------- */
+// return the first task with priority lower than prio
+
+static
+tsk_t *priv_rdy_below( unsigned prio )
+{
+	unsigned idx = prio / 32;
+	uint32_t map = ReadyMap[idx] & ((1UL << (prio % 32)) - 1);
+
+	if (map == 0)
+	{
+		uint32_t grp = ReadyGrp & ((1UL << idx) - 1);
+		if (grp == 0)
+			return &IDLE;
+		idx = priv_bit_msb(grp);
+		map = ReadyMap[idx];
+	}
+
+	return ReadyHead[idx * 32 + priv_bit_msb(map)];
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_tsk_insert( tsk_t *tsk )
+{
+	unsigned prio = tsk->prio;
+#if OS_ROBIN && HW_TIMER_SIZE == 0
+	tsk->slice = 0;
+#endif
+	assert(prio < OS_PRIO_LEVELS);
+
+	if (ReadyHead[prio] == 0)
+	{
+		ReadyHead[prio] = tsk;
+		ReadyMap[prio / 32] |= 1UL << (prio % 32);
+		ReadyGrp |= 1UL << (prio / 32);
+	}
+
+	priv_rdy_insert(&tsk->hdr, &priv_rdy_below(prio)->hdr);
+}
+
+/* -------------------------------------------------------------------------- */
+// insert the task at the front of its priority level
+
+static
+void priv_tsk_push( tsk_t *tsk )
+{
+	tsk_t *nxt = ReadyHead[tsk->prio];
+
+	if (nxt == 0)
+	{
+		priv_tsk_insert(tsk);
+		return;
+	}
+
+	ReadyHead[tsk->prio] = tsk;
+	priv_rdy_insert(&tsk->hdr, &nxt->hdr);
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_tsk_remove( tsk_t *tsk )
+{
+	unsigned prio = tsk->prio;
+	tsk_t  * nxt  = tsk->hdr.next;
+
+	if (ReadyHead[prio] == tsk)
+	{
+		if (nxt != &IDLE && nxt->prio == prio)
+		{
+			ReadyHead[prio] = nxt;
+		}
+		else
+		{
+			ReadyHead[prio] = 0;
+			if ((ReadyMap[prio / 32] &= ~(1UL << (prio % 32))) == 0)
+				ReadyGrp &= ~(1UL << (prio / 32));
+		}
+	}
+
+	priv_rdy_remove(&tsk->hdr);
+}
+
+#endif//OS_PRIO_LEVELS
+
+/* -------------------------------------------------------------------------- */
+// change priority of the current task
+
+static
+void priv_cur_prio( tsk_t *cur, unsigned prio )
+{
+#if OS_PRIO_LEVELS == 0
+	cur->prio = prio;
+	cur = cur->hdr.next;
+	if (cur->prio > prio)
+		port_ctx_switch();
+#else
+	if (cur->hdr.id == ID_READY && cur->guard == 0)
+	{
+		priv_tsk_remove(cur);
+		cur->prio = prio;
+		priv_tsk_push(cur);
+	}
+	else
+	{
+		cur->prio = prio;
+	}
+	if (cur != IDLE.hdr.next)
+		port_ctx_switch();
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+
+void core_tsk_insert( tsk_t *tsk )
+{
+	tsk->hdr.id = ID_READY;
+	priv_tsk_insert(tsk);
+	if (tsk == IDLE.hdr.next)
+		port_ctx_switch();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void core_tsk_remove( tsk_t *tsk )
+{
+	core_stk_remove(tsk);
+	tsk->hdr.id = ID_STOPPED;
+	priv_tsk_remove(tsk);
+	if (tsk == System.cur)
+		priv_ctx_switchNow();
+}
+
+/* -------------------------------------------------------------------------- */
+
+#if OS_STACK_SCAN
+
+#define STK_PAINT ((stk_t)~(stk_t)0) // value of the painted stack word
+
+static  tsk_t  * StkList = NULL; // list of tasks with scanned stacks
+static  tsk_t  * StkScan = NULL; // task being scanned
+
+static
+void priv_stk_insert( tsk_t *tsk )
+{
+	tsk_t *nxt;
+
+	tsk->stk.free = (unsigned)((stk_t *)tsk->sp - tsk->stack);
+	tsk->stk.pos = 0;
+
+	for (nxt = StkList; nxt != NULL; nxt = nxt->stk.next)
+		if (nxt == tsk)
+			return;
+
+	tsk->stk.next = StkList;
+	StkList = tsk;
+}
+
+void core_stk_remove( tsk_t *tsk )
+{
+	tsk_t **nxt;
+
+	for (nxt = &StkList; *nxt != NULL; nxt = &(*nxt)->stk.next)
+	{
+		if (*nxt == tsk)
+		{
+			*nxt = tsk->stk.next;
+			break;
+		}
+	}
+
+	if (StkScan == tsk)
+		StkScan = tsk->stk.next;
+	tsk->stk.pos = 0;
 }
 
-/* -------------------------------------------------------------------------- */
-
-static
-void priv_tsk_remove( tsk_t *tsk )
+void core_stk_scan( void )
 {
-	priv_rdy_remove(&tsk->hdr);
-}
-
-/* -------------------------------------------------------------------------- */
+	tsk_t   *tsk;
+	unsigned cnt;
 
-void core_tsk_insert( tsk_t *tsk )
-{
-	tsk->hdr.id = ID_READY;
-	priv_tsk_insert(tsk);
-	if (tsk == IDLE.hdr.next)
-		port_ctx_switch();
-}
+	do
+	{
+		sys_lock();
+		{
+			tsk = StkScan ? StkScan : StkList;
 
-/* -------------------------------------------------------------------------- */
+			for (cnt = OS_STACK_SCAN; tsk != NULL && cnt > 0; )
+			{
+				if (tsk->stk.pos < tsk->stk.free && tsk->stack[tsk->stk.pos] == STK_PAINT)
+				{
+					tsk->stk.pos++;
+					cnt--;
+				}
+				else
+				{
+					tsk->stk.free = tsk->stk.pos; // the first used stack word or the previous high-water mark
+					tsk->stk.pos = 0;
+					tsk = tsk->stk.next;
+				}
+			}
 
-void core_tsk_remove( tsk_t *tsk )
-{
-	tsk->hdr.id = ID_STOPPED;
-	priv_tsk_remove(tsk);
-	if (tsk == System.cur)
-		priv_ctx_switchNow();
+			StkScan = tsk;
+		}
+		sys_unlock();
+	}
+	while (tsk != NULL);
 }
 
+#endif // OS_STACK_SCAN
+
 /* -------------------------------------------------------------------------- */
 
 void core_ctx_init( tsk_t *tsk )
 {
-#ifdef DEBUG
+#if OS_STACK_SHARED
+	if (tsk->shr.mode)
+	{
+		tsk->shr.init = true; // the shared stack may be in use, the context is initialized at the dispatch
+		return;
+	}
+#endif
+#if defined(DEBUG) || OS_STACK_SCAN
 	if (tsk != System.cur)
 		memset(tsk->stack, 0xFF, tsk->size);
 #endif
 	tsk->sp = (ctx_t *)STK_CROP(tsk->stack, tsk->size) - 1;
 	port_ctx_init(tsk->sp, core_tsk_loop);
 	assert_ctx_integrity(tsk);
+#if OS_STACK_SCAN
+	if (tsk != System.cur)
+		priv_stk_insert(tsk);
+#endif
 }
 
 /* -------------------------------------------------------------------------- */
@@ -290,25 +1043,77 @@ void core_tsk_loop( void )
 {
 	for (;;)
 	{
+		core_cri_leave();
 		port_clr_lock();
 		System.cur->state();
 		port_set_lock();
+		core_cri_enter();
+#if OS_STACK_SHARED
+		System.cur->shr.init = System.cur->shr.mode; // the run is complete, the shared stack is released
+		core_ctx_switch();
+		System.cur->shr.init = false;
+#else
 		core_ctx_switch();
+#endif
 	}
 }
 
 /* -------------------------------------------------------------------------- */
 
+#if OS_QUEUE_BUCKETS
+
+// return the bucket of the BLOCKED queue for the task priority
+
+static
+unsigned priv_bkt_index( bkt_t *bkt, unsigned prio )
+{
+	return prio < bkt->size ? prio : bkt->size - 1;
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
 void core_tsk_append( tsk_t *tsk, tsk_t **que )
 {
-	tsk_t *nxt = *que;
+	tsk_t *nxt;
+#if OS_QUEUE_BUCKETS
+	bkt_t *bkt = ((obj_t *)que)->bkt;
+	unsigned idx;
+	uint32_t map;
+#endif
+
 	tsk->guard  = que;
 	tsk->hdr.id = ID_READY;
 
-	while (nxt && tsk->prio <= nxt->prio)
+#if OS_OBJECT_STATS
+	if (++((obj_t *)que)->stat.waiters > ((obj_t *)que)->stat.depth)
+		((obj_t *)que)->stat.depth = ((obj_t *)que)->stat.waiters;
+#endif
+
+#if OS_QUEUE_BUCKETS
+	if (bkt != NULL)
+	{
+		assert(bkt->size > 0 && bkt->size <= 32);
+
+		idx = priv_bkt_index(bkt, tsk->prio);
+		map = bkt->map & ~((1UL << idx) - 1);
+		if (map)   // append after the last task in the nearest bucket of the same or higher priority
+			que = bkt->tail[priv_bit_lsb(map)];
+		nxt = *que;
+
+		bkt->tail[idx] = &tsk->hdr.obj.queue;
+		bkt->map |= 1UL << idx;
+	}
+	else
+#endif
 	{
-		que = &nxt->hdr.obj.queue;
 		nxt = *que;
+		while (nxt && tsk->prio <= nxt->prio)
+		{
+			que = &nxt->hdr.obj.queue;
+			nxt = *que;
+		}
 	}
 
 	if (nxt)
@@ -324,6 +1129,28 @@ void core_tsk_unlink( tsk_t *tsk, unsigned event )
 {
 	tsk_t**que = tsk->back;
 	tsk_t *nxt = tsk->hdr.obj.queue;
+#if OS_QUEUE_BUCKETS
+	bkt_t *bkt = ((obj_t *)tsk->guard)->bkt;
+	unsigned idx;
+
+	if (bkt != NULL)
+	{
+		idx = priv_bkt_index(bkt, tsk->prio);
+		if (bkt->tail[idx] == &tsk->hdr.obj.queue) // the last task in the bucket
+		{
+			// the link field of the task is the first field of the task control block
+			if (que != tsk->guard && priv_bkt_index(bkt, ((tsk_t *)que)->prio) == idx)
+				bkt->tail[idx] = que;
+			else
+				bkt->map &= ~(1UL << idx);
+		}
+	}
+#endif
+
+#if OS_OBJECT_STATS
+	((obj_t *)tsk->guard)->stat.waiters--;
+#endif
+
 	tsk->event = event;
 	tsk->guard = 0;
 
@@ -334,27 +1161,57 @@ void core_tsk_unlink( tsk_t *tsk, unsigned event )
 
 /* -------------------------------------------------------------------------- */
 
-void core_tsk_transfer( tsk_t *tsk, tsk_t **que )
-{
-	core_tsk_unlink(tsk, tsk->event);
-	core_tsk_append(tsk, que);
-}
-
-/* -------------------------------------------------------------------------- */
-
 unsigned core_tsk_wait( tsk_t *tsk, tsk_t **que, bool yield )
 {
 	assert_tsk_context();
+#if OS_STACK_SHARED
+	assert(tsk == System.cur || !tsk->shr.mode || tsk->shr.init); // the frame of the preempted task would be discarded
+#endif
+
+#if OS_TASK_PROXY
+	if (que && tsk->pxy.tsk)           // the wait is delegated to the proxy task
+	{
+		tsk_t *pxy = tsk->pxy.tsk;
+		tsk->pxy.tsk = NULL;
+
+		pxy->start = tsk->start;
+		pxy->delay = tsk->delay;
+		pxy->prio  = tsk->prio;
+		pxy->tmp   = tsk->tmp;
+		tsk = pxy;
+		yield = false;
+	}
+#endif
 
 	if (que)
 	{
+		core_trc_put(TRC_WAIT, tsk, (uintptr_t)que, tsk->prio);
+#if OS_OBJECT_STATS
+		((obj_t *)que)->stat.waits++;
+		tsk->wait = core_cyc_time();
+#endif
+#if OS_TASK_PROXY
+		if (tsk->pxy.fun == NULL)  // proxy task is not in the READY queue
+#endif
 		priv_tsk_remove(tsk);
 		core_tmr_insert((tmr_t *)tsk);
 		core_tsk_append(tsk, que); // must be last; sets ID_READY
+#if OS_STACK_SHARED
+		tsk->shr.init = tsk->shr.mode; // the run is over, the shared stack is released
+#endif
 	}
 
 	if (yield)
+	{
 		priv_ctx_switchNow();
+#if OS_STACK_SHARED
+		if (tsk->shr.init)             // the wait is over before the switch, start the run again
+		{
+			tsk->shr.init = false;
+			core_tsk_flip((void *)STK_CROP(tsk->stack, tsk->size));
+		}
+#endif
+	}
 
 	return tsk->event;
 }
@@ -409,17 +1266,52 @@ void core_tsk_suspend( tsk_t *tsk )
 {
 	tsk->delay = INFINITE;
 
-	core_tsk_wait(tsk, &System.dly, tsk == System.cur);
+	core_tsk_wait(tsk, &System.dly.queue, tsk == System.cur);
+}
+
+/* -------------------------------------------------------------------------- */
+
+#if OS_OBJECT_STATS
+
+// update wait time statistics of the object the task 'tsk' is woken up from with the event 'event'
+static
+void priv_obj_wakeup( tsk_t *tsk, unsigned event )
+{
+	ost_t *stat = &((obj_t *)tsk->guard)->stat;
+	cyc_t  time = core_cyc_time() - tsk->wait;
+
+	stat->time += time;
+	if (stat->max < time)
+		stat->max = time;
+	if (event == E_TIMEOUT)
+		stat->timeouts++;
 }
 
+#endif
+
 /* -------------------------------------------------------------------------- */
 
 tsk_t *core_tsk_wakeup( tsk_t *tsk, unsigned event )
 {
 	if (tsk)
 	{
+#if OS_TASK_STATS
+		System.stat.wakeups++;
+#endif
+		core_trc_put(TRC_WAKEUP, tsk, event, tsk->prio);
+#if OS_OBJECT_STATS
+		priv_obj_wakeup(tsk, event);
+#endif
 		core_tsk_unlink(tsk, event);
 		priv_tmr_remove((tmr_t *)tsk);
+#if OS_TASK_PROXY
+		if (tsk->pxy.fun)              // proxy task
+		{
+			tsk->hdr.id = ID_STOPPED;
+			tsk->pxy.fun(tsk);
+		}
+		else
+#endif
 		core_tsk_insert(tsk);
 	}
 
@@ -449,6 +1341,12 @@ unsigned core_tsk_count( tsk_t *tsk )
 void core_tsk_prio( tsk_t *tsk, unsigned prio )
 {
 	mtx_t *mtx;
+	tsk_t**que;
+
+#if OS_STACK_SHARED
+	if (tsk->shr.mode)           // priority of the run-to-completion task is fixed
+		return;
+#endif
 
 	if (prio < tsk->basic)
 		prio = tsk->basic;
@@ -458,29 +1356,37 @@ void core_tsk_prio( tsk_t *tsk, unsigned prio )
 			if (prio < mtx->obj.queue->prio)
 				prio = mtx->obj.queue->prio;
 
+	prio = _TSK_PRIO(prio);      // limit the priority to the levels of the tasks' queue
+
 	if (tsk->prio != prio)
 	{
-		tsk->prio = prio;
+		core_trc_put(TRC_PRIO, tsk, tsk->prio, prio);
 
-		if (tsk == System.cur)       // current task
-		{
-			tsk = tsk->hdr.next;
-			if (tsk->prio > prio)
-				port_ctx_switch();
-		}
-		else
 		if (tsk->guard != 0)         // blocked task
 		{
-			core_tsk_transfer(tsk, tsk->guard);
+			que = tsk->guard;
+			core_tsk_unlink(tsk, tsk->event);
+			tsk->prio = prio;        // the bucket of the blocked task depends on its priority
+			core_tsk_append(tsk, que);
 			if (tsk->mtx.tree)
 				core_tsk_prio(tsk->mtx.tree->owner, prio);
 		}
 		else
+		if (tsk == System.cur)       // current task
+		{
+			priv_cur_prio(tsk, prio);
+		}
+		else
 		if (tsk->hdr.id == ID_READY) // ready task
 		{
 			priv_tsk_remove(tsk);
+			tsk->prio = prio;
 			core_tsk_insert(tsk);
 		}
+		else                         // stopped task
+		{
+			tsk->prio = prio;
+		}
 	}
 }
 
@@ -491,6 +1397,11 @@ void core_cur_prio( unsigned prio )
 	mtx_t *mtx;
 	tsk_t *tsk = System.cur;
 
+#if OS_STACK_SHARED
+	if (tsk->shr.mode)           // priority of the run-to-completion task is fixed
+		return;
+#endif
+
 	if (prio < tsk->basic)
 		prio = tsk->basic;
 
@@ -499,22 +1410,57 @@ void core_cur_prio( unsigned prio )
 			if (prio < mtx->obj.queue->prio)
 				prio = mtx->obj.queue->prio;
 
+	prio = _TSK_PRIO(prio);      // limit the priority to the levels of the tasks' queue
+
 	if (tsk->prio != prio)
 	{
-		tsk->prio = prio;
-		tsk = tsk->hdr.next;
-		if (tsk->prio > prio)
-			port_ctx_switch();
+		core_trc_put(TRC_PRIO, tsk, tsk->prio, prio);
+		priv_cur_prio(tsk, prio);
 	}
 }
 
 /* -------------------------------------------------------------------------- */
 
+#if OS_TASK_STATS
+
+// update run time statistics of the tasks 'cur' (switched from) and 'nxt' (switched to)
+// the task switched from is preempted if it is still ready (not blocked and not stopped)
+
+static
+void priv_tsk_stats( tsk_t *cur, tsk_t *nxt )
+{
+	cyc_t now = core_cyc_time();
+	cyc_t run = (cyc_t)(now - cur->stat.start);
+
+	cur->stat.time += run;
+	if (cur->stat.max < run)
+		cur->stat.max = run;
+	if (cur->hdr.id == ID_READY && cur->guard == NULL)
+		cur->stat.preempts++;
+
+	nxt->stat.start = now;
+	nxt->stat.switches++;
+
+	System.stat.switches++;
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#if OS_STACK_SHARED
+// the task holding the frame on the shared stack cannot be moved behind the tasks of the same priority
+#define priv_shr_movable( tsk ) (!(tsk)->shr.mode || (tsk)->shr.init)
+#else
+#define priv_shr_movable( tsk ) true
+#endif
+
 void *core_tsk_handler( void *sp )
 {
 	tsk_t *cur, *nxt;
 
 	port_set_lock();
+	core_cri_enter();
 	{
 		core_ctx_reset();
 
@@ -527,9 +1473,9 @@ void *core_tsk_handler( void *sp )
 		nxt = IDLE.hdr.next;
 
 #if OS_ROBIN && HW_TIMER_SIZE == 0
-		if (cur == nxt || (nxt->slice >= (OS_FREQUENCY)/(OS_ROBIN) && (nxt->slice = 0) == 0))
+		if (nxt != &IDLE && (cur == nxt || (nxt->slice >= (OS_FREQUENCY)/(OS_ROBIN) && (nxt->slice = 0) == 0)) && priv_shr_movable(nxt))
 #else
-		if (cur == nxt)
+		if (nxt != &IDLE && cur == nxt && priv_shr_movable(nxt))
 #endif
 		{
 			priv_tsk_remove(nxt);
@@ -537,6 +1483,26 @@ void *core_tsk_handler( void *sp )
 			nxt = IDLE.hdr.next;
 		}
 
+#if OS_STACK_SHARED
+		if (nxt != cur && nxt->shr.init) // the task starts the run on the shared stack
+		{
+			nxt->shr.init = false;
+			nxt->sp = (ctx_t *)STK_CROP(nxt->stack, nxt->size) - 1;
+			port_ctx_init(nxt->sp, core_tsk_loop);
+		}
+#endif
+
+		if (nxt != cur)
+		{
+#if OS_TASK_STATS
+			priv_tsk_stats(cur, nxt);
+#endif
+#if OS_STACK_SCAN
+			if (cur == &IDLE && StkScan != NULL) // the scanned part of the stack can be used before the scan is resumed
+				StkScan->stk.pos = 0;
+#endif
+			core_trc_put(TRC_SWITCH, nxt, (uintptr_t)cur, nxt->prio);
+		}
 		System.cur = nxt;
 
 		assert_ctx_integrity(nxt);
@@ -544,6 +1510,7 @@ void *core_tsk_handler( void *sp )
 		sp = nxt->sp;
 		nxt->sp = 0;
 	}
+	core_cri_leave();
 	port_clr_lock();
 
 	return sp;
@@ -613,6 +1580,212 @@ void core_mtx_reset( mtx_t *mtx, unsigned event )
 {
 	core_mtx_unlink(mtx);
 	core_all_wakeup(mtx->obj.queue, event);
+	core_obj_reset(&mtx->obj);
+}
+
+/* -------------------------------------------------------------------------- */
+// SYSTEM OBJECT SERVICES
+/* -------------------------------------------------------------------------- */
+
+#if OS_OBJECT_STATS
+
+// objects are added to the table at the first take / give request
+// and removed from it when they are initialized, reset or their resources are released
+
+static  obj_t  * Objects[OS_OBJECT_STATS]; // table of objects with statistics
+static  unsigned ObjectsLost = 0;          // number of objects not recorded because the table was full
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_obj_insert( obj_t *obj )
+{
+	obj_t **tab = NULL;
+	unsigned i;
+
+	for (i = 0; i < OS_OBJECT_STATS; i++)
+	{
+		if (Objects[i] == obj)  // the object has been initialized again
+			return;
+		if (Objects[i] == NULL && tab == NULL)
+			tab = &Objects[i];
+	}
+
+	if (tab)
+		*tab = obj;
+	else
+		ObjectsLost++;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_obj_remove( obj_t *obj )
+{
+	unsigned i;
+
+	for (i = 0; i < OS_OBJECT_STATS; i++)
+	{
+		if (Objects[i] == obj)
+		{
+			Objects[i] = NULL;
+			break;
+		}
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void core_obj_init( obj_t *obj )
+{
+	priv_obj_remove(obj);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void core_obj_reset( obj_t *obj )
+{
+	priv_obj_remove(obj);
+	memset(&obj->stat, 0, sizeof(ost_t));
+}
+
+/* -------------------------------------------------------------------------- */
+
+void core_obj_remove( void **res )
+{
+	priv_obj_remove((obj_t *)((char *)res - offsetof(obj_t, res)));
+}
+
+/* -------------------------------------------------------------------------- */
+
+void core_obj_stats( const obj_t *obj, ost_t *stats )
+{
+	sys_lock();
+	{
+		*stats = obj->stat;
+	}
+	sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void *core_obj_next( const void *obj )
+{
+	obj_t *nxt = NULL;
+	unsigned i = 0;
+
+	sys_lock();
+	{
+		if (obj != NULL)
+			while (i < OS_OBJECT_STATS && Objects[i++] != obj);
+
+		while (i < OS_OBJECT_STATS && (nxt = Objects[i++]) == NULL);
+	}
+	sys_unlock();
+
+	return nxt;
+}
+
+/* -------------------------------------------------------------------------- */
+
+unsigned core_obj_lost( void )
+{
+	unsigned lost;
+
+	sys_lock();
+	{
+		lost = ObjectsLost;
+	}
+	sys_unlock();
+
+	return lost;
+}
+
+#endif//OS_OBJECT_STATS
+
+/* -------------------------------------------------------------------------- */
+
+#if OS_TRACE_SIZE || OS_OBJECT_STATS
+
+void core_obj_event( unsigned id, void *obj )
+{
+#if OS_OBJECT_STATS
+	ost_t *stat = &((obj_t *)obj)->stat;
+
+	if (stat->takes == 0 && stat->gives == 0)
+		priv_obj_insert(obj);
+
+	if (id == TRC_TAKE)
+		stat->takes++;
+	else
+		stat->gives++;
+#endif
+	core_trc_put(id, obj, 0, System.cur->prio);
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+// SYSTEM RING BUFFER SERVICES
+/* -------------------------------------------------------------------------- */
+
+unsigned core_rng_put( char *buf, unsigned limit, unsigned pos, const char *data, unsigned size )
+{
+	unsigned cut = limit - pos;
+
+	if (size < cut)
+	{
+		if (data) memcpy(buf + pos, data, size);
+		return pos + size;
+	}
+
+	if (data)
+	{
+		memcpy(buf + pos, data, cut);
+		memcpy(buf, data + cut, size - cut);
+	}
+	return size - cut;
+}
+
+/* -------------------------------------------------------------------------- */
+
+unsigned core_rng_get( const char *buf, unsigned limit, unsigned pos, char *data, unsigned size )
+{
+	unsigned cut = limit - pos;
+
+	if (size < cut)
+	{
+		if (data) memcpy(data, buf + pos, size);
+		return pos + size;
+	}
+
+	if (data)
+	{
+		memcpy(data, buf + pos, cut);
+		memcpy(data + cut, buf, size - cut);
+	}
+	return size - cut;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void core_rng_span( rng_t *rng, char *buf, unsigned limit, unsigned pos, unsigned size )
+{
+	unsigned cut = limit - pos;
+
+	rng->data[0] = buf + pos;
+	rng->data[1] = buf;
+
+	if (size > cut)
+	{
+		rng->size[0] = cut;
+		rng->size[1] = size - cut;
+	}
+	else
+	{
+		rng->size[0] = size;
+		rng->size[1] = 0;
+	}
 }
 
 /* -------------------------------------------------------------------------- */
@@ -32,15 +32,82 @@
 #ifndef __STATEOSKERNEL_H
 #define __STATEOSKERNEL_H
 
+#include <stddef.h>
 #include <string.h>
 #include <stdlib.h>
 #include "oscore.h"
 
 /* -------------------------------------------------------------------------- */
 
+#if     OS_INPLACE_FUNCTION
+#undef  OS_FUNCTIONAL
+#define OS_FUNCTIONAL       ((OS_INPLACE_FUNCTION) + 1)
+#endif
+
+/* -------------------------------------------------------------------------- */
+
 #ifdef  __cplusplus
 
-#if OS_FUNCTIONAL
+#if OS_INPLACE_FUNCTION
+#include <new>
+#include <utility>
+#include <type_traits>
+
+/******************************************************************************
+ *
+ * Class             : InplaceFunction<>
+ *
+ * Description       : allocation-free replacement of std::function
+ *                     callable object is stored in the fixed-size storage of OS_INPLACE_FUNCTION pointers,
+ *                     only trivially copyable callable objects are accepted,
+ *                     so the function object can be copied byte-wise (e.g. by the job queue)
+ *                     and zero-filled memory represents an empty function object
+ *
+ * Note              : compilation error is generated if the callable object does not fit into the storage
+ *
+ ******************************************************************************/
+
+template<class F>
+class InplaceFunction;
+
+template<class R, class... A>
+class InplaceFunction<R( A... )>
+{
+	typedef R call_t( const void *, A... );
+
+	template<class T>
+	static R invoke( const void *_data, A... _args ) { return (*static_cast<T *>(const_cast<void *>(_data)))(std::forward<A>(_args)...); }
+
+	call_t *call_;
+	alignas(void *)
+	unsigned char data_[sizeof(void *) * (OS_INPLACE_FUNCTION)];
+
+	public:
+
+	InplaceFunction( void ):           call_(nullptr), data_() {}
+	InplaceFunction( std::nullptr_t ): call_(nullptr), data_() {}
+
+	template<class F, class T = typename std::decay<F>::type,
+	         typename std::enable_if<!std::is_same<T, InplaceFunction>::value, int>::type = 0,
+	         class = decltype(std::declval<T &>()(std::declval<A>()...))>
+	InplaceFunction( F &&_fun ): call_(invoke<T>), data_()
+	{
+		static_assert(sizeof(T) <= sizeof(data_), "callable object too large, increase OS_INPLACE_FUNCTION!");
+		static_assert(alignof(T) <= alignof(void *), "callable object with unsupported alignment!");
+		static_assert(std::is_trivially_copyable<T>::value, "callable object must be trivially copyable!");
+		::new (static_cast<void *>(data_)) T(std::forward<F>(_fun));
+	}
+
+	explicit
+	operator bool    ( void ) const     { return call_ != nullptr; }
+	R operator()     ( A... _args ) const { return call_(data_, std::forward<A>(_args)...); }
+};
+
+typedef InplaceFunction<void( void )>     FUN_t;
+static_assert(sizeof(FUN_t) == sizeof(void*)*(OS_FUNCTIONAL), "unexpected size of the in-place function!");
+typedef InplaceFunction<void( unsigned )> ACT_t;
+static_assert(sizeof(ACT_t) == sizeof(void*)*(OS_FUNCTIONAL), "unexpected size of the in-place function!");
+#elif OS_FUNCTIONAL
 #include <functional>
 typedef std::function<void( void )>     FUN_t;
 static_assert(sizeof(FUN_t) == sizeof(void*)*(OS_FUNCTIONAL), "incorrect value of OS_FUNCTIONAL constant!");
@@ -112,14 +179,38 @@ void port_sys_init( void );
 // initiate task 'tsk' for context switch
 void core_ctx_init( tsk_t *tsk );
 
+// remove task 'tsk' from the list of tasks with scanned stacks
+// scan the stacks of tasks incrementally, at most OS_STACK_SCAN words in one critical section (executed by the idle task)
+#if OS_STACK_SCAN
+void core_stk_remove( tsk_t *tsk );
+void core_stk_scan( void );
+#else
+__STATIC_INLINE
+void core_stk_remove( tsk_t *tsk ) { (void) tsk; }
+#endif
+
 // save status of the current process and force yield system control to the next
 void core_ctx_switch( void );
 
+// critical section profiler: mark the beginning / the end of the interrupt-masked region
+// the call site of the outermost region is the return address of core_cri_enter
+// must be called with the kernel locked
+#if OS_LOCK_PROFILE
+void core_cri_enter( void );
+void core_cri_leave( void );
+#else
+__STATIC_INLINE
+void core_cri_enter( void ) {}
+__STATIC_INLINE
+void core_cri_leave( void ) {}
+#endif
+
 // save status of the current process and immediately yield system control to the next
 __STATIC_INLINE
 void core_ctx_switchNow( void )
 {
 	core_ctx_switch();
+	core_cri_leave();
 	port_clr_lock(); __ISB();
 }
 
@@ -142,9 +233,20 @@ void core_tmr_insert( tmr_t *tmr );
 // remove task / timer 'tmr' from timers READY queue
 void core_tmr_remove( tmr_t *tmr );
 
+// remove the pending callback of timer 'tmr' from the queue of the timer daemon
+#if OS_TIMER_DAEMON
+void core_tmr_cancel( tmr_t *tmr );
+#else
+__STATIC_INLINE
+void core_tmr_cancel( tmr_t *tmr ) { (void) tmr; }
+#endif
+
 // timers queue handler procedure
 void core_tmr_handler( void );
 
+// return the task / timer following 'tmr' in timers READY queue; start and end with WAIT
+tmr_t *core_tmr_next( tmr_t *tmr );
+
 /* -------------------------------------------------------------------------- */
 
 // reset stack and restart the current task
@@ -158,15 +260,12 @@ void core_tsk_insert( tsk_t *tsk );
 // remove task 'tsk' from tasks READY queue
 void core_tsk_remove( tsk_t *tsk );
 
-// append task 'tsk' to the blocked queue 'que'
+// append task 'tsk' to the blocked queue 'que' of the object header
 void core_tsk_append( tsk_t *tsk, tsk_t **obj );
 
 // remove task 'tsk' from the blocked queue with event value 'event'
 void core_tsk_unlink( tsk_t *tsk, unsigned event );
 
-// transfer task 'tsk' to the blocked queue 'que'
-void core_tsk_transfer( tsk_t *tsk, tsk_t **que );
-
 // delay execution of current task for given duration of time 'delay'
 // append the current task to the blocked queue 'que'
 // remove the current task from tasks READY queue
@@ -284,6 +383,21 @@ cnt_t core_sys_time( void )
 #endif
 }
 
+// return current value of the cycle counter of the task statistics, the object statistics, the kernel trace, the critical section profiler and the timer daemon
+#if OS_TASK_STATS || OS_OBJECT_STATS || OS_TRACE_SIZE || OS_LOCK_PROFILE || OS_TIMER_DAEMON
+__STATIC_INLINE
+cyc_t core_cyc_time( void )
+{
+#if   defined(PORT_CYC_FREQUENCY)
+	return port_cyc_time();
+#elif defined(DWT_CTRL_CYCCNTENA_Msk) && defined(CPU_FREQUENCY)
+	return DWT->CYCCNT;
+#else
+	return core_sys_time();
+#endif
+}
+#endif
+
 // internal handler of system timer
 #if HW_TIMER_SIZE == 0
 void core_sys_tick( void );
@@ -297,6 +411,96 @@ void core_sys_tick( void )
 }
 #endif
 
+// identifiers of the kernel trace events
+enum
+{
+	TRC_SWITCH = 1, // context switch:      obj = next task, arg = previous task
+	TRC_WAKEUP,     // task wakeup:         obj = task,      arg = event value
+	TRC_WAIT,       // task blocked:        obj = task,      arg = object (BLOCKED queue)
+	TRC_PRIO,       // task priority:       obj = task,      arg = previous priority
+	TRC_TICK,       // timers' queue handler
+	TRC_TIMER,      // timer expiration:    obj = timer
+	TRC_TAKE,       // take / wait request: obj = object
+	TRC_GIVE        // give / send request: obj = object
+};
+
+// put the kernel trace event 'id' with object 'obj', argument 'arg' and priority 'prio' into the trace buffer
+// must be called with the kernel locked
+#if OS_TRACE_SIZE
+void core_trc_put( unsigned id, const void *obj, uintptr_t arg, unsigned prio );
+#else
+__STATIC_INLINE
+void core_trc_put( unsigned id, const void *obj, uintptr_t arg, unsigned prio ) { (void) id; (void) obj; (void) arg; (void) prio; }
+#endif
+
+// take / give request 'id' (TRC_TAKE / TRC_GIVE) of object 'obj' by the current task
+// the request is put into the trace buffer and counted in the object statistics
+// the object header must be the first field of the object
+// must be called with the kernel locked
+#if OS_TRACE_SIZE || OS_OBJECT_STATS
+void core_obj_event( unsigned id, void *obj );
+#else
+__STATIC_INLINE
+void core_obj_event( unsigned id, void *obj ) { (void) id; (void) obj; }
+#endif
+
+// update the max filling level of object 'obj' with the current level 'level'
+__STATIC_INLINE
+void core_obj_level( obj_t *obj, unsigned level )
+{
+#if OS_OBJECT_STATS
+	if (obj->stat.peak < level)
+		obj->stat.peak = level;
+#else
+	(void) obj; (void) level;
+#endif
+}
+
+// remove the object containing resources 'res' (allocated object's resource) from the table of objects with statistics
+// remove object 'obj' from the table of objects with statistics and clear its statistics (the object is reset);
+// must be called after the tasks waiting for the object are woken up
+// copy statistics of object 'obj' to 'stats'; return the next object in the table of objects with statistics (NULL => the first one)
+// return the number of objects not recorded because the table of objects with statistics was full
+#if OS_OBJECT_STATS
+void core_obj_remove( void **res );
+void core_obj_reset( obj_t *obj );
+void core_obj_stats( const obj_t *obj, ost_t *stats );
+void*core_obj_next( const void *obj );
+unsigned core_obj_lost( void );
+#else
+__STATIC_INLINE
+void core_obj_remove( void **res ) { (void) res; }
+__STATIC_INLINE
+void core_obj_reset( obj_t *obj ) { (void) obj; }
+#endif
+
+// ring buffer 'buf' of size 'limit' (stream buffer, message buffer)
+// copy 'size' bytes between the ring buffer at position 'pos' and 'data' in at most two contiguous segments
+// 'data' == NULL => data was written / read in place, only the position is moved
+// return the position following the copied data
+unsigned core_rng_put( char *buf, unsigned limit, unsigned pos, const char *data, unsigned size );
+unsigned core_rng_get( const char *buf, unsigned limit, unsigned pos, char *data, unsigned size );
+
+// set span 'rng' to 'size' bytes of the ring buffer 'buf' of size 'limit' at position 'pos'
+void core_rng_span( rng_t *rng, char *buf, unsigned limit, unsigned pos, unsigned size );
+
+// return the position 'pos' (less than 2 * 'limit') wrapped in the ring buffer of size 'limit'
+// 'mask' != 0 => size of the ring buffer is a power of two, the position is wrapped with the mask (see _RNG_MASK)
+__STATIC_INLINE
+unsigned core_rng_wrap( unsigned pos, unsigned limit, unsigned mask )
+{
+	if (mask)
+		return pos & mask;
+	return (pos < limit) ? pos : pos - limit;
+}
+
+// mask of the ring buffer of the object 'obj'
+#if OS_RING_POW2
+#define               core_rng_mask( obj ) ((obj)->mask)
+#else
+#define               core_rng_mask( obj ) 0U
+#endif
+
 // default handler of idle process
 void idle_tsk_default( void );
 
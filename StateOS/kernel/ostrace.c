@@ -0,0 +1,161 @@
+/******************************************************************************
+
+    @file    StateOS: ostrace.c
+    @author  Rajmund Szymanski
+    @date    17.10.2026
+    @brief   This file provides kernel trace for StateOS.
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+
+#include "ostrace.h"
+#include "inc/ostask.h"
+#include "inc/oscriticalsection.h"
+
+#if OS_TRACE_SIZE
+
+#if     ((OS_TRACE_SIZE) & ((OS_TRACE_SIZE) - 1)) != 0
+#error  osconfig.h: Incorrect OS_TRACE_SIZE value! Must be a power of 2.
+#endif
+
+/* -------------------------------------------------------------------------- */
+// KERNEL TRACE BUFFER
+/* -------------------------------------------------------------------------- */
+
+// trace points are executed with the kernel locked, so there is only one writer at a time
+// the writer never waits for the reader: the oldest records are overwritten
+// the write counter is advanced before the record is written,
+// so the reader can detect the records overwritten during the copy
+
+static  trc_t    Trace[OS_TRACE_SIZE];  // trace buffer
+static  volatile
+        unsigned TraceHead;             // number of records written
+static  unsigned TraceTail;             // number of records read
+static  unsigned TraceLost;             // number of records overwritten before they were read
+
+/* -------------------------------------------------------------------------- */
+
+void core_trc_put( unsigned id, const void *obj, uintptr_t arg, unsigned prio )
+{
+	trc_t *rec = &Trace[TraceHead++ % (OS_TRACE_SIZE)];
+
+	rec->time = core_cyc_time();
+	rec->obj  = obj;
+	rec->arg  = arg;
+	rec->id   = id;
+	rec->prio = prio;
+}
+
+/* -------------------------------------------------------------------------- */
+void trc_header( trh_t *hdr )
+/* -------------------------------------------------------------------------- */
+{
+	assert(hdr);
+
+	hdr->magic     = TRC_MAGIC;
+	hdr->version   = TRC_VERSION;
+	hdr->time_size = sizeof(cyc_t);
+	hdr->ptr_size  = sizeof(void *);
+	hdr->rec_size  = sizeof(trc_t);
+	hdr->frequency = CYC_FREQUENCY;
+	hdr->size      = OS_TRACE_SIZE;
+	hdr->lost      = TraceLost;
+	hdr->main      = (uintptr_t)&MAIN;
+	hdr->idle      = (uintptr_t)&IDLE;
+}
+
+/* -------------------------------------------------------------------------- */
+static
+bool priv_trc_get( trc_t *rec, unsigned last )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned head;
+
+	for (;;)
+	{
+		head = TraceHead;
+		if (head - TraceTail > OS_TRACE_SIZE)
+		{
+			TraceLost += head - TraceTail - OS_TRACE_SIZE;
+			TraceTail  = head - OS_TRACE_SIZE;
+		}
+		if (TraceTail == head || (int)(TraceTail - last) >= 0)
+			return false;
+
+		__COMPILER_BARRIER();
+		*rec = Trace[TraceTail % (OS_TRACE_SIZE)];
+		__COMPILER_BARRIER();
+
+		if (TraceHead - TraceTail <= OS_TRACE_SIZE) // the record has not been overwritten during the copy
+			break;
+	}
+
+	TraceTail++;
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned trc_read( trc_t *data, unsigned count )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned last = TraceHead;
+	unsigned n;
+
+	assert(data);
+
+	for (n = 0; n < count; n++)
+		if (!priv_trc_get(&data[n], last))
+			break;
+
+	return n;
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned trc_drain( stm_t *stm )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned last = TraceHead;
+	unsigned n;
+	trc_t    rec;
+
+	assert(stm);
+
+	for (n = 0; stm_space(stm) >= sizeof(trc_t); n++)
+	{
+		if (!priv_trc_get(&rec, last))
+			break;
+		sys_lock();
+		{
+			core_stm_give(stm, &rec, sizeof(trc_t)); // the request is not traced
+		}
+		sys_unlock();
+	}
+
+	return n;
+}
+
+/* -------------------------------------------------------------------------- */
+
+#endif//OS_TRACE_SIZE
@@ -0,0 +1,155 @@
+/******************************************************************************
+
+    @file    StateOS: ostrace.h
+    @author  Rajmund Szymanski
+    @date    17.10.2026
+    @brief   This file contains definitions of the kernel trace for StateOS.
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+
+#ifndef __STATEOSTRACE_H
+#define __STATEOSTRACE_H
+
+#include "oskernel.h"
+#include "inc/osstreambuffer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#define TRC_MAGIC    0x43525453UL // "STRC"
+#define TRC_VERSION  1
+
+/******************************************************************************
+ *
+ * Name              : trace record
+ *
+ ******************************************************************************/
+
+typedef struct __trc trc_t;
+
+struct __trc
+{
+	cyc_t    time;  // value of the cycle counter (frequency CYC_FREQUENCY)
+	const
+	void   * obj;   // object of the event (task, timer or kernel object)
+	uintptr_t arg;  // argument of the event (see TRC_XXX identifiers)
+	uint32_t id;    // identifier of the event (TRC_XXX)
+	uint32_t prio;  // priority of the task of the event (TRC_PRIO: new priority)
+};
+
+/******************************************************************************
+ *
+ * Name              : trace header
+ *
+ ******************************************************************************/
+
+typedef struct __trh trh_t;
+
+struct __trh
+{
+	uint32_t magic;     // TRC_MAGIC
+	uint16_t version;   // TRC_VERSION
+	uint8_t  time_size; // size of the time field of the trace record (in bytes)
+	uint8_t  ptr_size;  // size of the obj and arg fields of the trace record (in bytes)
+	uint32_t rec_size;  // size of the trace record (in bytes)
+	uint32_t frequency; // frequency of the cycle counter (CYC_FREQUENCY)
+	uint32_t size;      // capacity of the trace buffer (OS_TRACE_SIZE records)
+	uint32_t lost;      // number of records overwritten before they were read
+	uint64_t main;      // address of the main task
+	uint64_t idle;      // address of the idle task
+};
+
+/******************************************************************************
+ *
+ * Name              : trc_header
+ *
+ * Description       : get the header of the kernel trace, it should precede the records in the trace dump
+ *
+ * Parameters
+ *   hdr             : pointer to the trace header
+ *
+ * Return            : none
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     available only when OS_TRACE_SIZE > 0
+ *
+ ******************************************************************************/
+
+#if OS_TRACE_SIZE
+void trc_header( trh_t *hdr );
+#endif
+
+/******************************************************************************
+ *
+ * Name              : trc_read
+ *
+ * Description       : move the oldest records from the trace buffer to the given buffer
+ *                     the trace buffer is lock-free, records overwritten during the copy are skipped and counted as lost
+ *
+ * Parameters
+ *   data            : pointer to the buffer of trace records
+ *   count           : size of the buffer (in records)
+ *
+ * Return            : number of records read
+ *
+ * Note              : only one reader is allowed
+ *                     available only when OS_TRACE_SIZE > 0
+ *
+ ******************************************************************************/
+
+#if OS_TRACE_SIZE
+unsigned trc_read( trc_t *data, unsigned count );
+#endif
+
+/******************************************************************************
+ *
+ * Name              : trc_drain
+ *
+ * Description       : move the records written so far from the trace buffer to the stream buffer, as many as fit into it
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *
+ * Return            : number of records moved
+ *
+ * Note              : the function doesn't wait for free space in the stream buffer
+ *                     only one reader is allowed
+ *                     available only when OS_TRACE_SIZE > 0
+ *
+ ******************************************************************************/
+
+#if OS_TRACE_SIZE
+unsigned trc_drain( stm_t *stm );
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif//__STATEOSTRACE_H
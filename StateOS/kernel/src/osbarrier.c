@@ -33,6 +33,14 @@
 #include "inc/oscriticalsection.h"
 #include "osalloc.h"
 
+/* -------------------------------------------------------------------------- */
+
+#if OS_SLAB_BAR
+OS_SLB(bar_slb, bar_t, OS_SLAB_BAR);
+#else
+#define bar_slb NULL
+#endif
+
 /* -------------------------------------------------------------------------- */
 static
 void priv_bar_init( bar_t *bar, unsigned limit )
@@ -70,7 +78,7 @@ bar_t *bar_create( unsigned limit )
 
 	sys_lock();
 	{
-		bar = sys_alloc(sizeof(bar_t));
+		bar = core_slb_alloc(bar_slb, sizeof(bar_t));
 		priv_bar_init(bar, limit);
 		bar->obj.res = bar;
 	}
@@ -85,6 +93,7 @@ void priv_bar_reset( bar_t *bar, unsigned event )
 /* -------------------------------------------------------------------------- */
 {
 	core_all_wakeup(bar->obj.queue, event);
+	core_obj_reset(&bar->obj);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -113,7 +122,7 @@ void bar_destroy( bar_t *bar )
 	sys_lock();
 	{
 		priv_bar_reset(bar, bar->obj.res ? E_DELETED : E_STOPPED);
-		core_res_free(&bar->obj.res);
+		core_slb_free(bar_slb, &bar->obj.res);
 	}
 	sys_unlock();
 }
@@ -123,6 +132,8 @@ static
 unsigned priv_bar_take( bar_t *bar )
 /* -------------------------------------------------------------------------- */
 {
+	core_obj_event(TRC_TAKE, bar);
+
 	if (core_tsk_count(bar->obj.queue) + 1 == bar->limit)
 	{
 		core_all_wakeup(bar->obj.queue, E_SUCCESS);
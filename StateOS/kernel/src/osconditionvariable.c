@@ -33,6 +33,14 @@
 #include "inc/oscriticalsection.h"
 #include "osalloc.h"
 
+/* -------------------------------------------------------------------------- */
+
+#if OS_SLAB_CND
+OS_SLB(cnd_slb, cnd_t, OS_SLAB_CND);
+#else
+#define cnd_slb NULL
+#endif
+
 /* -------------------------------------------------------------------------- */
 static
 void priv_cnd_init( cnd_t *cnd )
@@ -66,7 +74,7 @@ cnd_t *cnd_create( void )
 
 	sys_lock();
 	{
-		cnd = sys_alloc(sizeof(cnd_t));
+		cnd = core_slb_alloc(cnd_slb, sizeof(cnd_t));
 		priv_cnd_init(cnd);
 		cnd->obj.res = cnd;
 	}
@@ -81,6 +89,7 @@ void priv_cnd_reset( cnd_t *cnd, unsigned event )
 /* -------------------------------------------------------------------------- */
 {
 	core_all_wakeup(cnd->obj.queue, event);
+	core_obj_reset(&cnd->obj);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -109,7 +118,7 @@ void cnd_destroy( cnd_t *cnd )
 	sys_lock();
 	{
 		priv_cnd_reset(cnd, cnd->obj.res ? E_DELETED : E_STOPPED);
-		core_res_free(&cnd->obj.res);
+		core_slb_free(cnd_slb, &cnd->obj.res);
 	}
 	sys_unlock();
 }
@@ -129,6 +138,8 @@ unsigned cnd_waitFor( cnd_t *cnd, mtx_t *mtx, cnt_t delay )
 
 	sys_lock();
 	{
+		core_obj_event(TRC_TAKE, cnd);
+
 		event = mtx_give(mtx);
 		if (event == E_SUCCESS)
 		{
@@ -158,6 +169,8 @@ unsigned cnd_waitUntil( cnd_t *cnd, mtx_t *mtx, cnt_t time )
 
 	sys_lock();
 	{
+		core_obj_event(TRC_TAKE, cnd);
+
 		event = mtx_give(mtx);
 		if (event == E_SUCCESS)
 		{
@@ -181,9 +194,24 @@ void cnd_give( cnd_t *cnd, bool all )
 
 	sys_lock();
 	{
+		core_obj_event(TRC_GIVE, cnd);
+
 		while (core_one_wakeup(cnd->obj.queue, E_SUCCESS) && all);
 	}
 	sys_unlock();
 }
 
 /* -------------------------------------------------------------------------- */
+#if OS_OBJECT_STATS
+void cnd_stats( cnd_t *cnd, ost_t *stats )
+/* -------------------------------------------------------------------------- */
+{
+	assert(cnd);
+	assert(cnd->obj.res!=RELEASED);
+	assert(stats);
+
+	core_obj_stats(&cnd->obj, stats);
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
@@ -0,0 +1,184 @@
+/******************************************************************************
+
+    @file    StateOS: oscriticalsection.c
+    @author  Rajmund Szymanski
+    @date    17.10.2026
+    @brief   This file provides set of functions for StateOS.
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+#include "inc/oscriticalsection.h"
+
+#if OS_LOCK_PROFILE
+
+/* -------------------------------------------------------------------------- */
+// CRITICAL SECTION PROFILER
+/* -------------------------------------------------------------------------- */
+
+// interrupt-masked regions never overlap, so one measurement is in progress at a time
+// core_cri_enter must not be inlined: its return address identifies the call site
+
+#if   defined(__GNUC__)
+#define CRI_NOINLINE   __attribute__((noinline))
+#define CRI_SITE()     __builtin_return_address(0)
+#elif defined(__CC_ARM)
+#define CRI_NOINLINE   __attribute__((noinline))
+#define CRI_SITE()     (void *)__return_address()
+#else
+#define CRI_NOINLINE
+#define CRI_SITE()     NULL
+#endif
+
+static  cri_t    CriSite[OS_LOCK_PROFILE]; // statistics of the call sites (open addressing)
+static  cri_t    CriOther;                 // statistics of the call sites that did not fit into the table
+static  bool     CriActive;                // measurement in progress
+static  const
+        void   * CriEnter;                 // call site of the current region
+static  cyc_t    CriStart;                 // beginning of the current region
+
+/* -------------------------------------------------------------------------- */
+
+CRI_NOINLINE
+void core_cri_enter( void )
+{
+	if (CriActive)
+		return;
+
+	CriActive = true;
+	CriEnter  = CRI_SITE();
+	CriStart  = core_cyc_time();
+}
+
+/* -------------------------------------------------------------------------- */
+static
+cri_t *priv_cri_find( const void *site )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned i = (unsigned)((uintptr_t)site / sizeof(void *)) % (OS_LOCK_PROFILE);
+	unsigned n;
+
+	if (site == NULL)
+		return &CriOther;
+
+	for (n = 0; n < OS_LOCK_PROFILE; n++)
+	{
+		cri_t *cri = &CriSite[i];
+		if (cri->site == site)
+			return cri;
+		if (cri->site == NULL)
+		{
+			cri->site = site;
+			return cri;
+		}
+		if (++i == OS_LOCK_PROFILE)
+			i = 0;
+	}
+
+	return &CriOther;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void core_cri_leave( void )
+{
+	cyc_t    time = core_cyc_time() - CriStart;
+	cri_t  * cri;
+	unsigned n;
+
+	if (!CriActive)
+		return;
+
+	CriActive = false;
+
+	cri = priv_cri_find(CriEnter);
+	cri->count++;
+	cri->time += time;
+	if (cri->max < time)
+		cri->max = time;
+	for (n = 0; time > 1 && n < CRI_BUCKETS - 1; time >>= 1, n++);
+	cri->hist[n]++;
+}
+
+/* -------------------------------------------------------------------------- */
+static
+unsigned priv_cri_insert( cri_t *data, unsigned count, unsigned size, const cri_t *cri )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned n = size < count ? size++ : size;
+
+	if (n == count && (n == 0 || data[n - 1].max >= cri->max))
+		return size;
+
+	if (n == count)
+		n--;
+	for (; n > 0 && data[n - 1].max < cri->max; n--)
+		data[n] = data[n - 1];
+	data[n] = *cri;
+
+	return size;
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned cri_stats( cri_t *data, unsigned count )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned size = 0;
+	unsigned n;
+	cri_t    cri;
+
+	assert(data);
+
+	// every record is copied in its own critical section to keep the interrupt latency low
+	for (n = 0; n <= OS_LOCK_PROFILE; n++)
+	{
+		sys_lock();
+		{
+			cri = n < OS_LOCK_PROFILE ? CriSite[n] : CriOther;
+		}
+		sys_unlock();
+
+		if (cri.count > 0)
+			size = priv_cri_insert(data, count, size, &cri);
+	}
+
+	return size;
+}
+
+/* -------------------------------------------------------------------------- */
+void cri_reset( void )
+/* -------------------------------------------------------------------------- */
+{
+	// the whole table is cleared at once, otherwise the probe sequences would be broken
+	sys_lock();
+	{
+		memset(CriSite, 0, sizeof(CriSite));
+		memset(&CriOther, 0, sizeof(CriOther));
+	}
+	sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+
+#endif//OS_LOCK_PROFILE
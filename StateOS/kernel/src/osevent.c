@@ -34,6 +34,14 @@
 #include "inc/oscriticalsection.h"
 #include "osalloc.h"
 
+/* -------------------------------------------------------------------------- */
+
+#if OS_SLAB_EVT
+OS_SLB(evt_slb, evt_t, OS_SLAB_EVT);
+#else
+#define evt_slb NULL
+#endif
+
 /* -------------------------------------------------------------------------- */
 static
 void priv_evt_init( evt_t *evt )
@@ -67,7 +75,7 @@ evt_t *evt_create( void )
 
 	sys_lock();
 	{
-		evt = sys_alloc(sizeof(evt_t));
+		evt = core_slb_alloc(evt_slb, sizeof(evt_t));
 		priv_evt_init(evt);
 		evt->obj.res = evt;
 	}
@@ -82,6 +90,7 @@ void priv_evt_reset( evt_t *evt, unsigned event )
 /* -------------------------------------------------------------------------- */
 {
 	core_all_wakeup(evt->obj.queue, event);
+	core_obj_reset(&evt->obj);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -110,7 +119,7 @@ void evt_destroy( evt_t *evt )
 	sys_lock();
 	{
 		priv_evt_reset(evt, evt->obj.res ? E_DELETED : E_STOPPED);
-		core_res_free(&evt->obj.res);
+		core_slb_free(evt_slb, &evt->obj.res);
 	}
 	sys_unlock();
 }
@@ -128,6 +137,8 @@ unsigned evt_waitFor( evt_t *evt, unsigned *data, cnt_t delay )
 
 	sys_lock();
 	{
+		core_obj_event(TRC_TAKE, evt);
+
 		System.cur->tmp.evt.data = data;
 		event = core_tsk_waitFor(&evt->obj.queue, delay);
 	}
@@ -149,6 +160,8 @@ unsigned evt_waitUntil( evt_t *evt, unsigned *data, cnt_t time )
 
 	sys_lock();
 	{
+		core_obj_event(TRC_TAKE, evt);
+
 		System.cur->tmp.evt.data = data;
 		event = core_tsk_waitUntil(&evt->obj.queue, time);
 	}
@@ -168,6 +181,8 @@ void evt_give( evt_t *evt, unsigned data )
 
 	sys_lock();
 	{
+		core_obj_event(TRC_GIVE, evt);
+
 		while ((tsk = evt->obj.queue) != 0)
 		{
 			*tsk->tmp.evt.data = data;
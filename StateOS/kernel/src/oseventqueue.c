@@ -43,6 +43,9 @@ void priv_evq_init( evq_t *evq, unsigned *data, unsigned bufsize )
 
 	evq->limit = bufsize / sizeof(unsigned);
 	evq->data  = data;
+#if OS_RING_POW2
+	evq->mask  = _RNG_MASK(evq->limit);
+#endif
 }
 
 /* -------------------------------------------------------------------------- */
@@ -77,7 +80,7 @@ evq_t *evq_create( unsigned limit )
 	sys_lock();
 	{
 		bufsize = limit * sizeof(unsigned);
-		tmp = sys_alloc(sizeof(struct evq_T) + bufsize);
+		tmp = sys_allocIn(OS_REGION_BUF, sizeof(struct evq_T) + bufsize);
 		priv_evq_init(evq = &tmp->evq, tmp->buf, bufsize);
 		evq->obj.res = evq;
 	}
@@ -96,6 +99,7 @@ void priv_evq_reset( evq_t *evq, unsigned event )
 	evq->tail  = 0;
 
 	core_all_wakeup(evq->obj.queue, event);
+	core_obj_reset(&evq->obj);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -138,7 +142,7 @@ void priv_evq_get( evq_t *evq, unsigned *data )
 
 	*data = evq->data[i++];
 
-	evq->head = (i < evq->limit) ? i : 0;
+	evq->head = core_rng_wrap(i, evq->limit, core_rng_mask(evq));
 	evq->count--;
 }
 
@@ -151,8 +155,9 @@ void priv_evq_put( evq_t *evq, const unsigned data )
 
 	evq->data[i++] = data;
 
-	evq->tail = (i < evq->limit) ? i : 0;
+	evq->tail = core_rng_wrap(i, evq->limit, core_rng_mask(evq));
 	evq->count++;
+	core_obj_level(&evq->obj, evq->count);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -161,8 +166,7 @@ void priv_evq_skip( evq_t *evq )
 /* -------------------------------------------------------------------------- */
 {
 	evq->count--;
-	evq->head++;
-	if (evq->head == evq->limit) evq->head = 0;
+	evq->head = core_rng_wrap(evq->head + 1, evq->limit, core_rng_mask(evq));
 }
 
 /* -------------------------------------------------------------------------- */
@@ -209,6 +213,8 @@ static
 unsigned priv_evq_take( evq_t *evq, unsigned *data )
 /* -------------------------------------------------------------------------- */
 {
+	core_obj_event(TRC_TAKE, evq);
+
 	if (evq->count > 0)
 	{
 		priv_evq_getUpdate(evq, data);
@@ -300,6 +306,8 @@ static
 unsigned priv_evq_give( evq_t *evq, unsigned data )
 /* -------------------------------------------------------------------------- */
 {
+	core_obj_event(TRC_GIVE, evq);
+
 	if (evq->count < evq->limit)
 	{
 		priv_evq_putUpdate(evq, data);
@@ -455,3 +463,16 @@ unsigned evq_limit( evq_t *evq )
 }
 
 /* -------------------------------------------------------------------------- */
+#if OS_OBJECT_STATS
+void evq_stats( evq_t *evq, ost_t *stats )
+/* -------------------------------------------------------------------------- */
+{
+	assert(evq);
+	assert(evq->obj.res!=RELEASED);
+	assert(stats);
+
+	core_obj_stats(&evq->obj, stats);
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
@@ -33,6 +33,14 @@
 #include "inc/oscriticalsection.h"
 #include "osalloc.h"
 
+/* -------------------------------------------------------------------------- */
+
+#if OS_SLAB_MUT
+OS_SLB(mut_slb, mut_t, OS_SLAB_MUT);
+#else
+#define mut_slb NULL
+#endif
+
 /* -------------------------------------------------------------------------- */
 static
 void priv_mut_init( mut_t *mut )
@@ -66,7 +74,7 @@ mut_t *mut_create( void )
 
 	sys_lock();
 	{
-		mut = sys_alloc(sizeof(mut_t));
+		mut = core_slb_alloc(mut_slb, sizeof(mut_t));
 		priv_mut_init(mut);
 		mut->obj.res = mut;
 	}
@@ -81,6 +89,7 @@ void priv_mut_reset( mut_t *mut, unsigned event )
 /* -------------------------------------------------------------------------- */
 {
 	core_all_wakeup(mut->obj.queue, event);
+	core_obj_reset(&mut->obj);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -109,7 +118,7 @@ void mut_destroy( mut_t *mut )
 	sys_lock();
 	{
 		priv_mut_reset(mut, mut->obj.res ? E_DELETED : E_STOPPED);
-		core_res_free(&mut->obj.res);
+		core_slb_free(mut_slb, &mut->obj.res);
 	}
 	sys_unlock();
 }
@@ -119,6 +128,8 @@ static
 unsigned priv_mut_take( mut_t *mut )
 /* -------------------------------------------------------------------------- */
 {
+	core_obj_event(TRC_TAKE, mut);
+
 	if (mut->owner == 0)
 	{
 		mut->owner = System.cur;
@@ -199,6 +210,8 @@ static
 unsigned priv_mut_give( mut_t *mut )
 /* -------------------------------------------------------------------------- */
 {
+	core_obj_event(TRC_GIVE, mut);
+
 	if (mut->owner == System.cur)
 	{
 		mut->owner = core_one_wakeup(mut->obj.queue, E_SUCCESS);
@@ -228,3 +241,16 @@ unsigned mut_give( mut_t *mut )
 }
 
 /* -------------------------------------------------------------------------- */
+#if OS_OBJECT_STATS
+void mut_stats( mut_t *mut, ost_t *stats )
+/* -------------------------------------------------------------------------- */
+{
+	assert(mut);
+	assert(mut->obj.res!=RELEASED);
+	assert(stats);
+
+	core_obj_stats(&mut->obj, stats);
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
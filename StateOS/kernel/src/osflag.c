@@ -34,6 +34,14 @@
 #include "inc/oscriticalsection.h"
 #include "osalloc.h"
 
+/* -------------------------------------------------------------------------- */
+
+#if OS_SLAB_FLG
+OS_SLB(flg_slb, flg_t, OS_SLAB_FLG);
+#else
+#define flg_slb NULL
+#endif
+
 /* -------------------------------------------------------------------------- */
 static
 void priv_flg_init( flg_t *flg, unsigned init )
@@ -69,7 +77,7 @@ flg_t *flg_create( unsigned init )
 
 	sys_lock();
 	{
-		flg = sys_alloc(sizeof(flg_t));
+		flg = core_slb_alloc(flg_slb, sizeof(flg_t));
 		priv_flg_init(flg, init);
 		flg->obj.res = flg;
 	}
@@ -86,6 +94,7 @@ void priv_flg_reset( flg_t *flg, unsigned event )
 	flg->flags = 0;
 
 	core_all_wakeup(flg->obj.queue, event);
+	core_obj_reset(&flg->obj);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -114,7 +123,7 @@ void flg_destroy( flg_t *flg )
 	sys_lock();
 	{
 		priv_flg_reset(flg, flg->obj.res ? E_DELETED : E_STOPPED);
-		core_res_free(&flg->obj.res);
+		core_slb_free(flg_slb, &flg->obj.res);
 	}
 	sys_unlock();
 }
@@ -126,6 +135,8 @@ unsigned priv_flg_take( flg_t *flg, unsigned flags, char mode )
 {
 	unsigned value;
 
+	core_obj_event(TRC_TAKE, flg);
+
 	if ((mode & flgIgnore) == 0)
 	{
 		value = flags;
@@ -232,6 +243,8 @@ unsigned flg_give( flg_t *flg, unsigned flags )
 
 	sys_lock();
 	{
+		core_obj_event(TRC_GIVE, flg);
+
 		flg->flags |= flags;
 
 		obj = &flg->obj;
@@ -298,3 +311,16 @@ unsigned flg_get( flg_t *flg )
 }
 
 /* -------------------------------------------------------------------------- */
+#if OS_OBJECT_STATS
+void flg_stats( flg_t *flg, ost_t *stats )
+/* -------------------------------------------------------------------------- */
+{
+	assert(flg);
+	assert(flg->obj.res!=RELEASED);
+	assert(stats);
+
+	core_obj_stats(&flg->obj, stats);
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
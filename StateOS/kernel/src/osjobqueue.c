@@ -43,6 +43,9 @@ void priv_job_init( job_t *job, fun_t **data, unsigned bufsize )
 
 	job->limit = bufsize / sizeof(fun_t *);
 	job->data  = data;
+#if OS_RING_POW2
+	job->mask  = _RNG_MASK(job->limit);
+#endif
 }
 
 /* -------------------------------------------------------------------------- */
@@ -77,7 +80,7 @@ job_t *job_create( unsigned limit )
 	sys_lock();
 	{
 		bufsize = limit * sizeof(fun_t *);
-		tmp = sys_alloc(sizeof(struct job_T) + bufsize);
+		tmp = sys_allocIn(OS_REGION_BUF, sizeof(struct job_T) + bufsize);
 		priv_job_init(job = &tmp->job, tmp->buf, bufsize);
 		job->obj.res = job;
 	}
@@ -96,6 +99,7 @@ void priv_job_reset( job_t *job, unsigned event )
 	job->tail  = 0;
 
 	core_all_wakeup(job->obj.queue, event);
+	core_obj_reset(&job->obj);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -137,7 +141,7 @@ void priv_job_get( job_t *job, fun_t **fun )
 	unsigned i = job->head;
 
 	*fun = job->data[i++];
-	job->head = (i < job->limit) ? i : 0;
+	job->head = core_rng_wrap(i, job->limit, core_rng_mask(job));
 	job->count--;
 }
 
@@ -150,8 +154,9 @@ void priv_job_put( job_t *job, fun_t *fun )
 
 	job->data[i++] = fun;
 
-	job->tail = (i < job->limit) ? i : 0;
+	job->tail = core_rng_wrap(i, job->limit, core_rng_mask(job));
 	job->count++;
+	core_obj_level(&job->obj, job->count);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -160,8 +165,7 @@ void priv_job_skip( job_t *job )
 /* -------------------------------------------------------------------------- */
 {
 	job->count--;
-	job->head++;
-	if (job->head == job->limit) job->head = 0;
+	job->head = core_rng_wrap(job->head + 1, job->limit, core_rng_mask(job));
 }
 
 /* -------------------------------------------------------------------------- */
@@ -208,6 +212,8 @@ static
 unsigned priv_job_take( job_t *job, fun_t **fun )
 /* -------------------------------------------------------------------------- */
 {
+	core_obj_event(TRC_TAKE, job);
+
 	if (job->count > 0)
 	{
 		priv_job_getUpdate(job, fun);
@@ -308,6 +314,8 @@ static
 unsigned priv_job_give( job_t *job, fun_t *fun )
 /* -------------------------------------------------------------------------- */
 {
+	core_obj_event(TRC_GIVE, job);
+
 	if (job->count < job->limit)
 	{
 		priv_job_putUpdate(job, fun);
@@ -467,3 +475,16 @@ unsigned job_limit( job_t *job )
 }
 
 /* -------------------------------------------------------------------------- */
+#if OS_OBJECT_STATS
+void job_stats( job_t *job, ost_t *stats )
+/* -------------------------------------------------------------------------- */
+{
+	assert(job);
+	assert(job->obj.res!=RELEASED);
+	assert(stats);
+
+	core_obj_stats(&job->obj, stats);
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
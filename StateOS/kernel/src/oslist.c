@@ -34,6 +34,14 @@
 #include "inc/oscriticalsection.h"
 #include "osalloc.h"
 
+/* -------------------------------------------------------------------------- */
+
+#if OS_SLAB_LST
+OS_SLB(lst_slb, lst_t, OS_SLAB_LST);
+#else
+#define lst_slb NULL
+#endif
+
 /* -------------------------------------------------------------------------- */
 static
 void priv_lst_init( lst_t *lst )
@@ -67,7 +75,7 @@ lst_t *lst_create( void )
 
 	sys_lock();
 	{
-		lst = sys_alloc(sizeof(lst_t));
+		lst = core_slb_alloc(lst_slb, sizeof(lst_t));
 		priv_lst_init(lst);
 		lst->obj.res = lst;
 	}
@@ -82,6 +90,7 @@ void priv_lst_reset( lst_t *lst, unsigned event )
 /* -------------------------------------------------------------------------- */
 {
 	core_all_wakeup(lst->obj.queue, event);
+	core_obj_reset(&lst->obj);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -110,7 +119,7 @@ void lst_destroy( lst_t *lst )
 	sys_lock();
 	{
 		priv_lst_reset(lst, lst->obj.res ? E_DELETED : E_STOPPED);
-		core_res_free(&lst->obj.res);
+		core_slb_free(lst_slb, &lst->obj.res);
 	}
 	sys_unlock();
 }
@@ -120,6 +129,8 @@ static
 unsigned priv_lst_take( lst_t *lst, void **data )
 /* -------------------------------------------------------------------------- */
 {
+	core_obj_event(TRC_TAKE, lst);
+
 	if (lst->head.next)
 	{
 		*data = lst->head.next + 1;
@@ -214,6 +225,8 @@ void lst_give( lst_t *lst, const void *data )
 
 	sys_lock();
 	{
+		core_obj_event(TRC_GIVE, lst);
+
 		tsk = core_one_wakeup(lst->obj.queue, E_SUCCESS);
 
 		if (tsk)
@@ -44,6 +44,9 @@ void priv_box_init( box_t *box, unsigned size, void *data, unsigned bufsize )
 	box->limit = (bufsize / size) * size;
 	box->size  = size;
 	box->data  = data;
+#if OS_RING_POW2
+	box->mask  = _RNG_MASK(box->limit);
+#endif
 }
 
 /* -------------------------------------------------------------------------- */
@@ -80,7 +83,7 @@ box_t *box_create( unsigned limit, unsigned size )
 	sys_lock();
 	{
 		bufsize = limit * size;
-		tmp = sys_alloc(sizeof(struct box_T) + bufsize);
+		tmp = sys_allocIn(OS_REGION_BUF, sizeof(struct box_T) + bufsize);
 		priv_box_init(box = &tmp->box, size, tmp->buf, bufsize);
 		box->obj.res = box;
 	}
@@ -99,6 +102,7 @@ void priv_box_reset( box_t *box, unsigned event )
 	box->tail  = 0;
 
 	core_all_wakeup(box->obj.queue, event);
+	core_obj_reset(&box->obj);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -137,13 +141,12 @@ static
 void priv_box_get( box_t *box, char *data )
 /* -------------------------------------------------------------------------- */
 {
-	unsigned i = box->head;
-	unsigned j = 0;
+	unsigned i = box->head + box->size;
 
-	do data[j++] = box->data[i++]; while (j < box->size);
+	memcpy(data, box->data + box->head, box->size);
 
-	box->head = (i < box->limit) ? i : 0;
-	box->count -= j;
+	box->head = core_rng_wrap(i, box->limit, core_rng_mask(box));
+	box->count -= box->size;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -151,13 +154,13 @@ static
 void priv_box_put( box_t *box, const char *data )
 /* -------------------------------------------------------------------------- */
 {
-	unsigned i = box->tail;
-	unsigned j = 0;
+	unsigned i = box->tail + box->size;
 
-	do box->data[i++] = data[j++]; while (j < box->size);
+	memcpy(box->data + box->tail, data, box->size);
 
-	box->tail = (i < box->limit) ? i : 0;
-	box->count += j;
+	box->tail = core_rng_wrap(i, box->limit, core_rng_mask(box));
+	box->count += box->size;
+	core_obj_level(&box->obj, box->count / box->size);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -166,8 +169,7 @@ void priv_box_skip( box_t *box )
 /* -------------------------------------------------------------------------- */
 {
 	box->count -= box->size;
-	box->head  += box->size;
-	if (box->head == box->limit) box->head = 0;
+	box->head   = core_rng_wrap(box->head + box->size, box->limit, core_rng_mask(box));
 }
 
 /* -------------------------------------------------------------------------- */
@@ -214,6 +216,8 @@ static
 unsigned priv_box_take( box_t *box, void *data )
 /* -------------------------------------------------------------------------- */
 {
+	core_obj_event(TRC_TAKE, box);
+
 	if (box->count > 0)
 	{
 		priv_box_getUpdate(box, data);
@@ -305,6 +309,8 @@ static
 unsigned priv_box_give( box_t *box, const void *data )
 /* -------------------------------------------------------------------------- */
 {
+	core_obj_event(TRC_GIVE, box);
+
 	if (box->count < box->limit)
 	{
 		priv_box_putUpdate(box, data);
@@ -464,3 +470,16 @@ unsigned box_limit( box_t *box )
 }
 
 /* -------------------------------------------------------------------------- */
+#if OS_OBJECT_STATS
+void box_stats( box_t *box, ost_t *stats )
+/* -------------------------------------------------------------------------- */
+{
+	assert(box);
+	assert(box->obj.res!=RELEASED);
+	assert(stats);
+
+	core_obj_stats(&box->obj, stats);
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
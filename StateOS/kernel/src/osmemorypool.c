@@ -106,7 +106,7 @@ mem_t *mem_create( unsigned limit, unsigned size )
 	sys_lock();
 	{
 		bufsize = limit * (1 + MEM_SIZE(size)) * sizeof(que_t);
-		tmp = sys_alloc(sizeof(struct mem_T) + bufsize);
+		tmp = sys_allocIn(OS_REGION_BUF, sizeof(struct mem_T) + bufsize);
 		priv_mem_init(mem = &tmp->mem, size, tmp->buf, bufsize);
 		mem->lst.obj.res = mem;
 	}
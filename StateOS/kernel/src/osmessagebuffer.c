@@ -43,6 +43,9 @@ void priv_msg_init( msg_t *msg, void *data, unsigned bufsize )
 
 	msg->limit = bufsize;
 	msg->data  = data;
+#if OS_RING_POW2
+	msg->mask  = _RNG_MASK(msg->limit);
+#endif
 }
 
 /* -------------------------------------------------------------------------- */
@@ -77,7 +80,7 @@ msg_t *msg_create( unsigned limit )
 	sys_lock();
 	{
 		bufsize = limit;
-		tmp = sys_alloc(sizeof(struct msg_T) + bufsize);
+		tmp = sys_allocIn(OS_REGION_BUF, sizeof(struct msg_T) + bufsize);
 		priv_msg_init(msg = &tmp->msg, tmp->buf, bufsize);
 		msg->obj.res = msg;
 	}
@@ -95,6 +98,7 @@ void priv_msg_reset( msg_t *msg, unsigned event )
 	msg->tail  = 0;
 
 	core_all_wakeup(msg->obj.queue, event);
+	core_obj_reset(&msg->obj);
 }
 
 
@@ -134,13 +138,7 @@ static
 void priv_msg_peek( msg_t *msg, char *data, unsigned size )
 /* -------------------------------------------------------------------------- */
 {
-	unsigned i = msg->head;
-
-	while (size--)
-	{
-		*data++ = msg->data[i++];
-		if (i >= msg->limit) i = 0;
-	}
+	core_rng_get(msg->data, msg->limit, msg->head, data, size);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -148,15 +146,8 @@ static
 void priv_msg_get( msg_t *msg, char *data, unsigned size )
 /* -------------------------------------------------------------------------- */
 {
-	unsigned i = msg->head;
-
 	msg->count -= size;
-	while (size--)
-	{
-		*data++ = msg->data[i++];
-		if (i >= msg->limit) i = 0;
-	}
-	msg->head = i;
+	msg->head = core_rng_get(msg->data, msg->limit, msg->head, data, size);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -164,15 +155,9 @@ static
 void priv_msg_put( msg_t *msg, const char *data, unsigned size )
 /* -------------------------------------------------------------------------- */
 {
-	unsigned i = msg->tail;
-
 	msg->count += size;
-	while (size--)
-	{
-		msg->data[i++] = *data++;
-		if (i >= msg->limit) i = 0;
-	}
-	msg->tail = i;
+	core_obj_level(&msg->obj, msg->count);
+	msg->tail = core_rng_put(msg->data, msg->limit, msg->tail, data, size);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -181,8 +166,17 @@ void priv_msg_skip( msg_t *msg, unsigned size )
 /* -------------------------------------------------------------------------- */
 {
 	msg->count -= size;
-	msg->head  += size;
-	if (msg->head >= msg->limit) msg->head -= msg->limit;
+	msg->head   = core_rng_wrap(msg->head + size, msg->limit, core_rng_mask(msg));
+}
+
+/* -------------------------------------------------------------------------- */
+static
+void priv_msg_span( msg_t *msg, rng_t *rng, unsigned pos, unsigned size )
+/* -------------------------------------------------------------------------- */
+{
+	pos = core_rng_wrap(pos + sizeof(unsigned), msg->limit, core_rng_mask(msg));
+
+	core_rng_span(rng, msg->data, msg->limit, pos, size);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -285,6 +279,8 @@ static
 unsigned priv_msg_take( msg_t *msg, char *data, unsigned size )
 /* -------------------------------------------------------------------------- */
 {
+	core_obj_event(TRC_TAKE, msg);
+
 	if (msg->count > 0)
 	{
 		if (size >= priv_msg_size(msg))
@@ -380,6 +376,8 @@ static
 unsigned priv_msg_give( msg_t *msg, const char *data, unsigned size )
 /* -------------------------------------------------------------------------- */
 {
+	core_obj_event(TRC_GIVE, msg);
+
 	if (msg->count + sizeof(unsigned) + size <= msg->limit)
 	{
 		priv_msg_putUpdate(msg, data, size);
@@ -476,6 +474,8 @@ static
 unsigned priv_msg_push( msg_t *msg, const void *data, unsigned size )
 /* -------------------------------------------------------------------------- */
 {
+	core_obj_event(TRC_GIVE, msg);
+
 	if (sizeof(unsigned) + size <= msg->limit)
 	{
 		priv_msg_skipUpdate(msg, size);
@@ -508,6 +508,109 @@ unsigned msg_push( msg_t *msg, const void *data, unsigned size )
 	return event;
 }
 
+/* -------------------------------------------------------------------------- */
+static
+unsigned priv_msg_reserve( msg_t *msg, rng_t *rng, unsigned size )
+/* -------------------------------------------------------------------------- */
+{
+	core_obj_event(TRC_GIVE, msg);
+
+	if (msg->count + sizeof(unsigned) + size <= msg->limit)
+	{
+		priv_msg_span(msg, rng, msg->tail, size);
+		return E_SUCCESS;
+	}
+
+	if (sizeof(unsigned) + size <= msg->limit)
+		return E_TIMEOUT;
+
+	return E_FAILURE;
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned msg_reserve( msg_t *msg, rng_t *rng, unsigned size )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned event;
+
+	assert(msg);
+	assert(msg->obj.res!=RELEASED);
+	assert(msg->data);
+	assert(msg->limit);
+	assert(rng);
+
+	sys_lock();
+	{
+		event = priv_msg_reserve(msg, rng, size);
+	}
+	sys_unlock();
+
+	return event;
+}
+
+/* -------------------------------------------------------------------------- */
+void msg_commit( msg_t *msg, unsigned size )
+/* -------------------------------------------------------------------------- */
+{
+	assert(msg);
+	assert(msg->obj.res!=RELEASED);
+	assert(msg->data);
+	assert(msg->limit);
+
+	sys_lock();
+	{
+		assert(msg->count + sizeof(unsigned) + size <= msg->limit);
+
+		priv_msg_putUpdate(msg, NULL, size);
+	}
+	sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned msg_peekSpan( msg_t *msg, rng_t *rng )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned len = E_TIMEOUT;
+
+	assert(msg);
+	assert(msg->obj.res!=RELEASED);
+	assert(msg->data);
+	assert(msg->limit);
+	assert(rng);
+
+	sys_lock();
+	{
+		core_obj_event(TRC_TAKE, msg);
+
+		if (msg->count > 0)
+		{
+			len = priv_msg_size(msg);
+			priv_msg_span(msg, rng, msg->head, len);
+		}
+	}
+	sys_unlock();
+
+	return len;
+}
+
+/* -------------------------------------------------------------------------- */
+void msg_release( msg_t *msg )
+/* -------------------------------------------------------------------------- */
+{
+	assert(msg);
+	assert(msg->obj.res!=RELEASED);
+	assert(msg->data);
+	assert(msg->limit);
+
+	sys_lock();
+	{
+		assert(msg->count > 0);
+
+		priv_msg_getUpdate(msg, NULL, 0);
+	}
+	sys_unlock();
+}
+
 /* -------------------------------------------------------------------------- */
 unsigned msg_count( msg_t *msg )
 /* -------------------------------------------------------------------------- */
@@ -582,3 +685,16 @@ unsigned msg_size( msg_t *msg )
 }
 
 /* -------------------------------------------------------------------------- */
+#if OS_OBJECT_STATS
+void msg_stats( msg_t *msg, ost_t *stats )
+/* -------------------------------------------------------------------------- */
+{
+	assert(msg);
+	assert(msg->obj.res!=RELEASED);
+	assert(stats);
+
+	core_obj_stats(&msg->obj, stats);
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
@@ -34,6 +34,14 @@
 #include "inc/oscriticalsection.h"
 #include "osalloc.h"
 
+/* -------------------------------------------------------------------------- */
+
+#if OS_SLAB_MTX
+OS_SLB(mtx_slb, mtx_t, OS_SLAB_MTX);
+#else
+#define mtx_slb NULL
+#endif
+
 /* -------------------------------------------------------------------------- */
 static
 void priv_mtx_init( mtx_t *mtx, unsigned mode, unsigned prio )
@@ -73,7 +81,7 @@ mtx_t *mtx_create( unsigned mode, unsigned prio )
 
 	sys_lock();
 	{
-		mtx = sys_alloc(sizeof(mtx_t));
+		mtx = core_slb_alloc(mtx_slb, sizeof(mtx_t));
 		priv_mtx_init(mtx, mode, prio);
 		mtx->obj.res = mtx;
 	}
@@ -108,7 +116,7 @@ void mtx_destroy( mtx_t *mtx )
 	sys_lock();
 	{
 		core_mtx_reset(mtx, mtx->obj.res ? E_DELETED : E_STOPPED);
-		core_res_free(&mtx->obj.res);
+		core_slb_free(mtx_slb, &mtx->obj.res);
 	}
 	sys_unlock();
 }
@@ -156,6 +164,8 @@ static
 unsigned priv_mtx_take( mtx_t *mtx )
 /* -------------------------------------------------------------------------- */
 {
+	core_obj_event(TRC_TAKE, mtx);
+
 	if ((mtx->mode & mtxPrioMASK) == mtxPrioProtect && mtx->prio < System.cur->prio)
 		return E_FAILURE;
 
@@ -277,6 +287,8 @@ static
 unsigned priv_mtx_give( mtx_t *mtx )
 /* -------------------------------------------------------------------------- */
 {
+	core_obj_event(TRC_GIVE, mtx);
+
 	if ((mtx->mode & (mtxTypeMASK + mtxRobust)) == mtxNormal || mtx->owner == System.cur)
 	{
 		if (mtx->count > 0)
@@ -315,3 +327,16 @@ unsigned mtx_give( mtx_t *mtx )
 }
 
 /* -------------------------------------------------------------------------- */
+#if OS_OBJECT_STATS
+void mtx_stats( mtx_t *mtx, ost_t *stats )
+/* -------------------------------------------------------------------------- */
+{
+	assert(mtx);
+	assert(mtx->obj.res!=RELEASED);
+	assert(stats);
+
+	core_obj_stats(&mtx->obj, stats);
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
@@ -33,6 +33,14 @@
 #include "inc/oscriticalsection.h"
 #include "osalloc.h"
 
+/* -------------------------------------------------------------------------- */
+
+#if OS_SLAB_SEM
+OS_SLB(sem_slb, sem_t, OS_SLAB_SEM);
+#else
+#define sem_slb NULL
+#endif
+
 /* -------------------------------------------------------------------------- */
 static
 void priv_sem_init( sem_t *sem, unsigned init, unsigned limit )
@@ -70,7 +78,7 @@ sem_t *sem_create( unsigned init, unsigned limit )
 
 	sys_lock();
 	{
-		sem = sys_alloc(sizeof(sem_t));
+		sem = core_slb_alloc(sem_slb, sizeof(sem_t));
 		priv_sem_init(sem, init, limit);
 		sem->obj.res = sem;
 	}
@@ -87,6 +95,7 @@ void priv_sem_reset( sem_t *sem, unsigned event )
 	sem->count = 0;
 
 	core_all_wakeup(sem->obj.queue, event);
+	core_obj_reset(&sem->obj);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -115,7 +124,7 @@ void sem_destroy( sem_t *sem )
 	sys_lock();
 	{
 		priv_sem_reset(sem, sem->obj.res ? E_DELETED : E_STOPPED);
-		core_res_free(&sem->obj.res);
+		core_slb_free(sem_slb, &sem->obj.res);
 	}
 	sys_unlock();
 }
@@ -125,6 +134,8 @@ static
 unsigned priv_sem_take( sem_t *sem )
 /* -------------------------------------------------------------------------- */
 {
+	core_obj_event(TRC_TAKE, sem);
+
 	if (sem->count > 0)
 	{
 		if (core_one_wakeup(sem->obj.queue, E_SUCCESS) == 0)
@@ -203,6 +214,8 @@ static
 unsigned priv_sem_give( sem_t *sem )
 /* -------------------------------------------------------------------------- */
 {
+	core_obj_event(TRC_GIVE, sem);
+
 	if (sem->count > sem->limit - 1)
 		return E_TIMEOUT;
 
@@ -213,6 +226,7 @@ unsigned priv_sem_give( sem_t *sem )
 		return E_FAILURE;
 
 	sem->count++;
+	core_obj_level(&sem->obj, sem->count);
 	return E_SUCCESS;
 }
 
@@ -297,3 +311,16 @@ unsigned sem_getValue( sem_t *sem )
 }
 
 /* -------------------------------------------------------------------------- */
+#if OS_OBJECT_STATS
+void sem_stats( sem_t *sem, ost_t *stats )
+/* -------------------------------------------------------------------------- */
+{
+	assert(sem);
+	assert(sem->obj.res!=RELEASED);
+	assert(stats);
+
+	core_obj_stats(&sem->obj, stats);
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
@@ -34,6 +34,14 @@
 #include "inc/oscriticalsection.h"
 #include "osalloc.h"
 
+/* -------------------------------------------------------------------------- */
+
+#if OS_SLAB_SIG
+OS_SLB(sig_slb, sig_t, OS_SLAB_SIG);
+#else
+#define sig_slb NULL
+#endif
+
 /* -------------------------------------------------------------------------- */
 static
 void priv_sig_init( sig_t *sig, unsigned mask )
@@ -69,7 +77,7 @@ sig_t *sig_create( unsigned mask )
 
 	sys_lock();
 	{
-		sig = sys_alloc(sizeof(sig_t));
+		sig = core_slb_alloc(sig_slb, sizeof(sig_t));
 		priv_sig_init(sig, mask);
 		sig->obj.res = sig;
 	}
@@ -86,6 +94,7 @@ void priv_sig_reset( sig_t *sig, unsigned event )
 	sig->sigset = 0;
 
 	core_all_wakeup(sig->obj.queue, event);
+	core_obj_reset(&sig->obj);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -114,7 +123,7 @@ void sig_destroy( sig_t *sig )
 	sys_lock();
 	{
 		priv_sig_reset(sig, sig->obj.res ? E_DELETED : E_STOPPED);
-		core_res_free(&sig->obj.res);
+		core_slb_free(sig_slb, &sig->obj.res);
 	}
 	sys_unlock();
 }
@@ -126,6 +135,8 @@ unsigned priv_sig_take( sig_t *sig, unsigned sigset )
 {
 	unsigned signo = E_TIMEOUT;
 
+	core_obj_event(TRC_TAKE, sig);
+
 	sigset &= sig->sigset;
 	sigset &= -sigset;
 	sig->sigset &= ~sigset | sig->mask;
@@ -216,6 +227,8 @@ void sig_give( sig_t *sig, unsigned signo )
 
 	sys_lock();
 	{
+		core_obj_event(TRC_GIVE, sig);
+
 		sig->sigset |= sigset;
 
 		obj = &sig->obj;
@@ -43,6 +43,9 @@ void priv_stm_init( stm_t *stm, void *data, unsigned bufsize )
 
 	stm->limit = bufsize;
 	stm->data  = data;
+#if OS_RING_POW2
+	stm->mask  = _RNG_MASK(stm->limit);
+#endif
 }
 
 /* -------------------------------------------------------------------------- */
@@ -77,7 +80,7 @@ stm_t *stm_create( unsigned limit )
 	sys_lock();
 	{
 		bufsize = limit;
-		tmp = sys_alloc(sizeof(struct stm_T) + bufsize);
+		tmp = sys_allocIn(OS_REGION_BUF, sizeof(struct stm_T) + bufsize);
 		priv_stm_init(stm = &tmp->stm, tmp->buf, bufsize);
 		stm->obj.res = stm;
 	}
@@ -96,6 +99,7 @@ void priv_stm_reset( stm_t *stm, unsigned event )
 	stm->tail  = 0;
 
 	core_all_wakeup(stm->obj.queue, event);
+	core_obj_reset(&stm->obj);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -134,15 +138,8 @@ static
 void priv_stm_get( stm_t *stm, char *data, unsigned size )
 /* -------------------------------------------------------------------------- */
 {
-	unsigned i = stm->head;
-
 	stm->count -= size;
-	while (size--)
-	{
-		*data++ = stm->data[i++];
-		if (i >= stm->limit) i = 0;
-	}
-	stm->head = i;
+	stm->head = core_rng_get(stm->data, stm->limit, stm->head, data, size);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -150,15 +147,9 @@ static
 void priv_stm_put( stm_t *stm, const char *data, unsigned size )
 /* -------------------------------------------------------------------------- */
 {
-	unsigned i = stm->tail;
-
 	stm->count += size;
-	while (size--)
-	{
-		stm->data[i++] = *data++;
-		if (i >= stm->limit) i = 0;
-	}
-	stm->tail = i;
+	core_obj_level(&stm->obj, stm->count);
+	stm->tail = core_rng_put(stm->data, stm->limit, stm->tail, data, size);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -167,8 +158,59 @@ void priv_stm_skip( stm_t *stm, unsigned size )
 /* -------------------------------------------------------------------------- */
 {
 	stm->count -= size;
-	stm->head  += size;
-	if (stm->head >= stm->limit) stm->head -= stm->limit;
+	stm->head   = core_rng_wrap(stm->head + size, stm->limit, core_rng_mask(stm));
+}
+
+/* -------------------------------------------------------------------------- */
+static
+tsk_t *priv_stm_reader( stm_t *stm )
+/* -------------------------------------------------------------------------- */
+{
+	tsk_t *tsk = stm->obj.queue;
+
+	while (tsk != 0 && tsk->tmp.stm.min == 0)
+		tsk = tsk->hdr.obj.queue;
+
+	return tsk;
+}
+
+/* -------------------------------------------------------------------------- */
+static
+tsk_t *priv_stm_writer( stm_t *stm )
+/* -------------------------------------------------------------------------- */
+{
+	tsk_t *tsk = stm->obj.queue;
+
+	while (tsk != 0 && tsk->tmp.stm.min != 0)
+		tsk = tsk->hdr.obj.queue;
+
+	return tsk;
+}
+
+/* -------------------------------------------------------------------------- */
+static
+void priv_stm_fill( stm_t *stm )
+/* -------------------------------------------------------------------------- */
+{
+	tsk_t  * tsk;
+	unsigned size;
+
+	while ((tsk = priv_stm_writer(stm)) != 0)
+	{
+		size = tsk->tmp.stm.size;
+		if (stm->count + size > stm->limit)
+		{
+			if (!tsk->tmp.stm.part || stm->count == stm->limit)
+				break;
+			size = stm->limit - stm->count;
+		}
+		priv_stm_put(stm, tsk->tmp.stm.data.out, size);
+		tsk->tmp.stm.data.out += size;
+		tsk->tmp.stm.size -= size;
+		if (tsk->tmp.stm.size > 0)
+			break;
+		core_one_wakeup(tsk, E_SUCCESS);
+	}
 }
 
 /* -------------------------------------------------------------------------- */
@@ -179,44 +221,62 @@ unsigned priv_stm_getUpdate( stm_t *stm, char *data, unsigned size )
 	if (size > stm->count)
 		size = stm->count;
 	priv_stm_get(stm, data, size);
-
-	while (stm->obj.queue != 0 && stm->count + stm->obj.queue->tmp.stm.size <= stm->limit)
-	{
-		priv_stm_put(stm, stm->obj.queue->tmp.stm.data.out, stm->obj.queue->tmp.stm.size);
-		core_one_wakeup(stm->obj.queue, E_SUCCESS);
-	}
+	priv_stm_fill(stm);
 
 	return size;
 }
 
 /* -------------------------------------------------------------------------- */
 static
-void priv_stm_putUpdate( stm_t *stm, const char *data, unsigned size )
+void priv_stm_flush( stm_t *stm, unsigned level )
 /* -------------------------------------------------------------------------- */
 {
-	priv_stm_put(stm, data, size);
+	tsk_t  * tsk;
+	unsigned size;
 
-	while (stm->obj.queue != 0 && stm->count > 0)
+	if (priv_stm_writer(stm) != 0) // a waiting writer needs the space
+		level = 1;
+
+	while ((tsk = priv_stm_reader(stm)) != 0 && stm->count > 0 &&
+	      (stm->count >= tsk->tmp.stm.min || stm->count >= level))
 	{
-		size = stm->obj.queue->tmp.stm.size;
+		size = tsk->tmp.stm.size;
 		if (size > stm->count)
 			size = stm->count;
-		priv_stm_get(stm, stm->obj.queue->tmp.stm.data.in, size);
-		core_one_wakeup(stm->obj.queue, size);
+		priv_stm_get(stm, tsk->tmp.stm.data.in, size);
+		core_one_wakeup(tsk, size);
 	}
 }
 
+/* -------------------------------------------------------------------------- */
+static
+void priv_stm_putUpdate( stm_t *stm, const char *data, unsigned size )
+/* -------------------------------------------------------------------------- */
+{
+	priv_stm_put(stm, data, size);
+	priv_stm_flush(stm, stm->limit);
+}
+
 /* -------------------------------------------------------------------------- */
 static
 void priv_stm_skipUpdate( stm_t *stm, unsigned size )
 /* -------------------------------------------------------------------------- */
 {
-	while (stm->obj.queue != 0)
+	tsk_t  * tsk;
+	unsigned len;
+
+	while ((tsk = priv_stm_writer(stm)) != 0)
 	{
-		if (stm->count + stm->obj.queue->tmp.stm.size > stm->limit)
-			priv_stm_skip(stm, stm->count + stm->obj.queue->tmp.stm.size - stm->limit);
-		priv_stm_put(stm, stm->obj.queue->tmp.stm.data.out, stm->obj.queue->tmp.stm.size);
-		core_one_wakeup(stm->obj.queue, E_SUCCESS);
+		len = tsk->tmp.stm.size;
+		if (len > stm->limit) // only the last part of the streamed data would remain
+		{
+			tsk->tmp.stm.data.out += len - stm->limit;
+			len = stm->limit;
+		}
+		if (stm->count + len > stm->limit)
+			priv_stm_skip(stm, stm->count + len - stm->limit);
+		priv_stm_put(stm, tsk->tmp.stm.data.out, len);
+		core_one_wakeup(tsk, E_SUCCESS);
 	}
 
 	if (stm->count + size > stm->limit)
@@ -225,10 +285,12 @@ void priv_stm_skipUpdate( stm_t *stm, unsigned size )
 
 /* -------------------------------------------------------------------------- */
 static
-unsigned priv_stm_take( stm_t *stm, char *data, unsigned size )
+unsigned priv_stm_take( stm_t *stm, char *data, unsigned min, unsigned size )
 /* -------------------------------------------------------------------------- */
 {
-	if (stm->count > 0)
+	core_obj_event(TRC_TAKE, stm);
+
+	if (stm->count >= min || (stm->count > 0 && priv_stm_writer(stm) != 0))
 		return priv_stm_getUpdate(stm, data, size);
 
 	return E_TIMEOUT;
@@ -248,7 +310,7 @@ unsigned stm_take( stm_t *stm, void *data, unsigned size )
 
 	sys_lock();
 	{
-		len = priv_stm_take(stm, data, size);
+		len = priv_stm_take(stm, data, 1, size);
 	}
 	sys_unlock();
 
@@ -270,12 +332,13 @@ unsigned stm_waitFor( stm_t *stm, void *data, unsigned size, cnt_t delay )
 
 	sys_lock();
 	{
-		len = priv_stm_take(stm, data, size);
+		len = priv_stm_take(stm, data, 1, size);
 
 		if (len == E_TIMEOUT)
 		{
 			System.cur->tmp.stm.data.in = data;
 			System.cur->tmp.stm.size = size;
+			System.cur->tmp.stm.min = 1;
 			len = core_tsk_waitFor(&stm->obj.queue, delay);
 		}
 	}
@@ -299,12 +362,13 @@ unsigned stm_waitUntil( stm_t *stm, void *data, unsigned size, cnt_t time )
 
 	sys_lock();
 	{
-		len = priv_stm_take(stm, data, size);
+		len = priv_stm_take(stm, data, 1, size);
 
 		if (len == E_TIMEOUT)
 		{
 			System.cur->tmp.stm.data.in = data;
 			System.cur->tmp.stm.size = size;
+			System.cur->tmp.stm.min = 1;
 			len = core_tsk_waitUntil(&stm->obj.queue, time);
 		}
 	}
@@ -314,10 +378,74 @@ unsigned stm_waitUntil( stm_t *stm, void *data, unsigned size, cnt_t time )
 }
 
 /* -------------------------------------------------------------------------- */
-static
-unsigned priv_stm_give( stm_t *stm, const char *data, unsigned size )
+unsigned stm_waitMinFor( stm_t *stm, void *data, unsigned min, unsigned size, cnt_t delay )
 /* -------------------------------------------------------------------------- */
 {
+	unsigned len;
+
+	assert_tsk_context();
+	assert(stm);
+	assert(stm->obj.res!=RELEASED);
+	assert(stm->data);
+	assert(stm->limit);
+	assert(data);
+	assert(min > 0 && min <= size && min <= stm->limit);
+
+	sys_lock();
+	{
+		len = priv_stm_take(stm, data, min, size);
+
+		if (len == E_TIMEOUT)
+		{
+			System.cur->tmp.stm.data.in = data;
+			System.cur->tmp.stm.size = size;
+			System.cur->tmp.stm.min = min;
+			len = core_tsk_waitFor(&stm->obj.queue, delay);
+		}
+	}
+	sys_unlock();
+
+	return len;
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned stm_waitMinUntil( stm_t *stm, void *data, unsigned min, unsigned size, cnt_t time )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned len;
+
+	assert_tsk_context();
+	assert(stm);
+	assert(stm->obj.res!=RELEASED);
+	assert(stm->data);
+	assert(stm->limit);
+	assert(data);
+	assert(min > 0 && min <= size && min <= stm->limit);
+
+	sys_lock();
+	{
+		len = priv_stm_take(stm, data, min, size);
+
+		if (len == E_TIMEOUT)
+		{
+			System.cur->tmp.stm.data.in = data;
+			System.cur->tmp.stm.size = size;
+			System.cur->tmp.stm.min = min;
+			len = core_tsk_waitUntil(&stm->obj.queue, time);
+		}
+	}
+	sys_unlock();
+
+	return len;
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned core_stm_give( stm_t *stm, const void *data, unsigned size )
+/* -------------------------------------------------------------------------- */
+{
+	if (stm->count + size > stm->limit)
+		priv_stm_flush(stm, 1);
+
 	if (stm->count + size <= stm->limit)
 	{
 		priv_stm_putUpdate(stm, data, size);
@@ -330,6 +458,16 @@ unsigned priv_stm_give( stm_t *stm, const char *data, unsigned size )
 	return E_FAILURE;
 }
 
+/* -------------------------------------------------------------------------- */
+static
+unsigned priv_stm_give( stm_t *stm, const char *data, unsigned size )
+/* -------------------------------------------------------------------------- */
+{
+	core_obj_event(TRC_GIVE, stm);
+
+	return core_stm_give(stm, data, size);
+}
+
 /* -------------------------------------------------------------------------- */
 unsigned stm_give( stm_t *stm, const void *data, unsigned size )
 /* -------------------------------------------------------------------------- */
@@ -372,6 +510,8 @@ unsigned stm_sendFor( stm_t *stm, const void *data, unsigned size, cnt_t delay )
 		{
 			System.cur->tmp.stm.data.out = data;
 			System.cur->tmp.stm.size = size;
+			System.cur->tmp.stm.min = 0;
+			System.cur->tmp.stm.part = false;
 			event = core_tsk_waitFor(&stm->obj.queue, delay);
 		}
 	}
@@ -401,6 +541,8 @@ unsigned stm_sendUntil( stm_t *stm, const void *data, unsigned size, cnt_t time
 		{
 			System.cur->tmp.stm.data.out = data;
 			System.cur->tmp.stm.size = size;
+			System.cur->tmp.stm.min = 0;
+			System.cur->tmp.stm.part = false;
 			event = core_tsk_waitUntil(&stm->obj.queue, time);
 		}
 	}
@@ -409,11 +551,113 @@ unsigned stm_sendUntil( stm_t *stm, const void *data, unsigned size, cnt_t time
 	return event;
 }
 
+/* -------------------------------------------------------------------------- */
+static
+unsigned priv_stm_write( stm_t *stm, const char *data, unsigned size )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned len = 0;
+	unsigned part;
+
+	core_obj_event(TRC_GIVE, stm);
+
+	while (len < size && stm->count < stm->limit)
+	{
+		part = size - len;
+		if (part > stm->limit - stm->count)
+			part = stm->limit - stm->count;
+		priv_stm_putUpdate(stm, data + len, part);
+		len += part;
+	}
+
+	return len;
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned stm_writeFor( stm_t *stm, const void *data, unsigned size, cnt_t delay )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned len;
+	unsigned event;
+
+	assert_tsk_context();
+	assert(stm);
+	assert(stm->obj.res!=RELEASED);
+	assert(stm->data);
+	assert(stm->limit);
+	assert(data);
+
+	sys_lock();
+	{
+		len = priv_stm_write(stm, data, size);
+
+		if (len < size)
+		{
+			System.cur->tmp.stm.data.out = (const char *)data + len;
+			System.cur->tmp.stm.size = size - len;
+			System.cur->tmp.stm.min = 0;
+			System.cur->tmp.stm.part = true;
+			event = core_tsk_waitFor(&stm->obj.queue, delay);
+			if (event == E_SUCCESS)
+				len = size;
+			else
+			if (event == E_TIMEOUT)
+				len = size - System.cur->tmp.stm.size;
+			else
+				len = event;
+		}
+	}
+	sys_unlock();
+
+	return len;
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned stm_writeUntil( stm_t *stm, const void *data, unsigned size, cnt_t time )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned len;
+	unsigned event;
+
+	assert_tsk_context();
+	assert(stm);
+	assert(stm->obj.res!=RELEASED);
+	assert(stm->data);
+	assert(stm->limit);
+	assert(data);
+
+	sys_lock();
+	{
+		len = priv_stm_write(stm, data, size);
+
+		if (len < size)
+		{
+			System.cur->tmp.stm.data.out = (const char *)data + len;
+			System.cur->tmp.stm.size = size - len;
+			System.cur->tmp.stm.min = 0;
+			System.cur->tmp.stm.part = true;
+			event = core_tsk_waitUntil(&stm->obj.queue, time);
+			if (event == E_SUCCESS)
+				len = size;
+			else
+			if (event == E_TIMEOUT)
+				len = size - System.cur->tmp.stm.size;
+			else
+				len = event;
+		}
+	}
+	sys_unlock();
+
+	return len;
+}
+
 /* -------------------------------------------------------------------------- */
 static
 unsigned priv_stm_push( stm_t *stm, const void *data, unsigned size )
 /* -------------------------------------------------------------------------- */
 {
+	core_obj_event(TRC_GIVE, stm);
+
 	if (size <= stm->limit)
 	{
 		priv_stm_skipUpdate(stm, size);
@@ -446,6 +690,111 @@ unsigned stm_push( stm_t *stm, const void *data, unsigned size )
 	return event;
 }
 
+/* -------------------------------------------------------------------------- */
+static
+unsigned priv_stm_reserve( stm_t *stm, rng_t *rng, unsigned size )
+/* -------------------------------------------------------------------------- */
+{
+	if (stm->count + size > stm->limit)
+		priv_stm_flush(stm, 1);
+
+	if (stm->count + size <= stm->limit)
+	{
+		core_obj_event(TRC_GIVE, stm);
+		core_rng_span(rng, stm->data, stm->limit, stm->tail, size);
+		return E_SUCCESS;
+	}
+
+	if (size <= stm->limit)
+		return E_TIMEOUT;
+
+	return E_FAILURE;
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned stm_reserve( stm_t *stm, rng_t *rng, unsigned size )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned event;
+
+	assert(stm);
+	assert(stm->obj.res!=RELEASED);
+	assert(stm->data);
+	assert(stm->limit);
+	assert(rng);
+
+	sys_lock();
+	{
+		event = priv_stm_reserve(stm, rng, size);
+	}
+	sys_unlock();
+
+	return event;
+}
+
+/* -------------------------------------------------------------------------- */
+void stm_commit( stm_t *stm, unsigned size )
+/* -------------------------------------------------------------------------- */
+{
+	assert(stm);
+	assert(stm->obj.res!=RELEASED);
+	assert(stm->data);
+	assert(stm->limit);
+
+	sys_lock();
+	{
+		assert(stm->count + size <= stm->limit);
+
+		priv_stm_putUpdate(stm, NULL, size);
+	}
+	sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned stm_peekSpan( stm_t *stm, rng_t *rng )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned len = E_TIMEOUT;
+
+	assert(stm);
+	assert(stm->obj.res!=RELEASED);
+	assert(stm->data);
+	assert(stm->limit);
+	assert(rng);
+
+	sys_lock();
+	{
+		core_obj_event(TRC_TAKE, stm);
+
+		if (stm->count > 0)
+		{
+			len = stm->count;
+			core_rng_span(rng, stm->data, stm->limit, stm->head, len);
+		}
+	}
+	sys_unlock();
+
+	return len;
+}
+
+/* -------------------------------------------------------------------------- */
+void stm_release( stm_t *stm, unsigned size )
+/* -------------------------------------------------------------------------- */
+{
+	assert(stm);
+	assert(stm->obj.res!=RELEASED);
+	assert(stm->data);
+	assert(stm->limit);
+
+	sys_lock();
+	{
+		assert(size <= stm->count);
+
+		priv_stm_getUpdate(stm, NULL, size);
+	}
+	sys_unlock();
+}
+
 /* -------------------------------------------------------------------------- */
 unsigned stm_count( stm_t *stm )
 /* -------------------------------------------------------------------------- */
@@ -501,3 +850,16 @@ unsigned stm_limit( stm_t *stm )
 }
 
 /* -------------------------------------------------------------------------- */
+#if OS_OBJECT_STATS
+void stm_stats( stm_t *stm, ost_t *stats )
+/* -------------------------------------------------------------------------- */
+{
+	assert(stm);
+	assert(stm->obj.res!=RELEASED);
+	assert(stats);
+
+	core_obj_stats(&stm->obj, stats);
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
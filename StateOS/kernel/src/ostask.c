@@ -34,6 +34,17 @@
 #include "inc/oscriticalsection.h"
 #include "osalloc.h"
 
+/* -------------------------------------------------------------------------- */
+
+// slab cache is used for tasks with the default stack size (OS_STACK_SIZE)
+
+#if OS_SLAB_TSK
+struct tsk_S { tsk_t tsk; stk_t buf[STK_SIZE(OS_STACK_SIZE)]; };
+OS_SLB(tsk_slb, struct tsk_S, OS_SLAB_TSK);
+#else
+#define tsk_slb NULL
+#endif
+
 /* -------------------------------------------------------------------------- */
 static
 void priv_tsk_init( tsk_t *tsk, unsigned prio, fun_t *state, stk_t *stack, unsigned size )
@@ -41,8 +52,8 @@ void priv_tsk_init( tsk_t *tsk, unsigned prio, fun_t *state, stk_t *stack, unsig
 {
 	core_hdr_init(&tsk->hdr);
 
-	tsk->prio  = prio;
-	tsk->basic = prio;
+	tsk->prio  = _TSK_PRIO(prio);
+	tsk->basic = _TSK_PRIO(prio);
 	tsk->state = state;
 	tsk->stack = stack;
 	tsk->size  = size;
@@ -69,6 +80,51 @@ void tsk_init( tsk_t *tsk, unsigned prio, fun_t *state, stk_t *stack, unsigned s
 	sys_unlock();
 }
 
+/* -------------------------------------------------------------------------- */
+#if OS_STACK_SHARED
+void tsk_initShared( tsk_t *tsk, unsigned prio, fun_t *state, stk_t *stack, unsigned size )
+/* -------------------------------------------------------------------------- */
+{
+	assert_tsk_context();
+	assert(tsk);
+	assert(state);
+	assert(stack);
+	assert(size);
+
+	sys_lock();
+	{
+		memset(tsk, 0, sizeof(tsk_t));
+		tsk->shr.mode = true;
+		priv_tsk_init(tsk, prio, state, stack, size);
+	}
+	sys_unlock();
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
+#if OS_TASK_PROXY
+void tsk_proxy( tsk_t *pxy, void (*fun)( tsk_t * ) )
+/* -------------------------------------------------------------------------- */
+{
+	assert_tsk_context();
+	assert(pxy == NULL || fun);
+	assert(pxy == NULL || pxy->guard == NULL);
+
+	sys_lock();
+	{
+		if (pxy)
+		{
+			memset(pxy, 0, sizeof(tsk_t));
+			pxy->event   = E_TIMEOUT;
+			pxy->pxy.fun = fun;
+		}
+
+		System.cur->pxy.tsk = pxy;
+	}
+	sys_unlock();
+}
+#endif
+
 /* -------------------------------------------------------------------------- */
 tsk_t *wrk_create( unsigned prio, fun_t *state, unsigned size )
 /* -------------------------------------------------------------------------- */
@@ -85,7 +141,12 @@ tsk_t *wrk_create( unsigned prio, fun_t *state, unsigned size )
 	sys_lock();
 	{
 		bufsize = STK_SIZE(size) * sizeof(stk_t);
-		tmp = sys_alloc(sizeof(struct tsk_T) + bufsize);
+#if OS_SLAB_TSK
+		if (STK_SIZE(size) == STK_SIZE(OS_STACK_SIZE))
+			tmp = core_slb_alloc(tsk_slb, sizeof(struct tsk_T) + bufsize);
+		else
+#endif
+			tmp = sys_allocIn(OS_REGION_TSK, sizeof(struct tsk_T) + bufsize);
 		priv_tsk_init(tsk = &tmp->tsk, prio, state, tmp->buf, bufsize);
 		tsk->hdr.obj.res = tsk;
 	}
@@ -103,7 +164,7 @@ tsk_t *wrk_detached( unsigned prio, fun_t *state, unsigned size )
 	sys_lock();
 	{
 		tsk = wrk_create(prio, state, size);
-		tsk->join = DETACHED;
+		tsk->join.queue = DETACHED;
 	}
 	sys_unlock();
 
@@ -164,19 +225,19 @@ unsigned tsk_detach( tsk_t *tsk )
 
 	sys_lock();
 	{
-		if (tsk->join == DETACHED ||               // task has already been detached
-		    tsk->hdr.obj.res == 0)                 // task is undetachable
+		if (tsk->join.queue == DETACHED ||               // task has already been detached
+		    tsk->hdr.obj.res == 0)                       // task is undetachable
 			event = E_FAILURE;
 		else
-		if (tsk->hdr.id == ID_STOPPED)             // task is already inactive
+		if (tsk->hdr.id == ID_STOPPED)                   // task is already inactive
 		{
-			core_res_free(&tsk->hdr.obj.res);      // release resources
+			core_slb_free(tsk_slb, &tsk->hdr.obj.res);   // release resources
 			event = E_SUCCESS;
 		}
-		else                                       // task is active and can be detached
+		else                                             // task is active and can be detached
 		{
-			core_tsk_wakeup(tsk->join, E_FAILURE); // notify waiting task
-			tsk->join = DETACHED;                  // mark as detached
+			core_tsk_wakeup(tsk->join.queue, E_FAILURE); // notify waiting task
+			tsk->join.queue = DETACHED;                  // mark as detached
 			event = E_SUCCESS;
 		}
 	}
@@ -197,19 +258,19 @@ unsigned tsk_join( tsk_t *tsk )
 
 	sys_lock();
 	{
-		if (tsk->join != JOINABLE ||                        // task is unjoinable
-		    tsk == System.cur)                              // deadlock detected
+		if (tsk->join.queue != JOINABLE ||                        // task is unjoinable
+		    tsk == System.cur)                                    // deadlock detected
 			event = E_FAILURE;
 		else
-		if (tsk->hdr.id == ID_STOPPED)                      // task is already inactive
+		if (tsk->hdr.id == ID_STOPPED)                            // task is already inactive
 			event = E_SUCCESS;
-		else                                                // task is active
-			event = core_tsk_waitFor(&tsk->join, INFINITE); // wait for termination
+		else                                                      // task is active
+			event = core_tsk_waitFor(&tsk->join.queue, INFINITE); // wait for termination
 
-		if (event != E_FAILURE &&                           // task has not been detached
-		    event != E_DELETED &&                           // task has not been deleted
-		    tsk->hdr.id == ID_STOPPED)                      // task is still inactive
-			core_res_free(&tsk->hdr.obj.res);               // release resources
+		if (event != E_FAILURE &&                                 // task has not been detached
+		    event != E_DELETED &&                                 // task has not been deleted
+		    tsk->hdr.id == ID_STOPPED)                            // task is still inactive
+			core_slb_free(tsk_slb, &tsk->hdr.obj.res);            // release resources
 	}
 	sys_unlock();
 
@@ -246,6 +307,7 @@ void priv_tsk_stop( tsk_t *tsk )
 	{
 		core_tsk_unlink(tsk, 0);         // remove task from blocked queue; ignored event value
 		core_tmr_remove((tmr_t *)tsk);   // remove task from timers queue
+		core_stk_remove(tsk);            // remove task from the list of tasks with scanned stacks
 	}
 	else
 //	if (tsk->hdr.id == ID_READY)         // ready task
@@ -256,6 +318,12 @@ void priv_tsk_stop( tsk_t *tsk )
 void idle_tsk_default( void )
 /* -------------------------------------------------------------------------- */
 {
+#if OS_HEAP_WALK
+	sys_heapWalk();
+#endif
+#if OS_STACK_SCAN
+	core_stk_scan();
+#endif
 	__WFI();
 }
 
@@ -267,21 +335,21 @@ void idle_tsk_destructor( void )
 
 	sys_lock();
 	{
-		while (System.des)
+		while (System.des.queue)
 		{
-			tsk = System.des;                          // task waiting for destruction
+			tsk = System.des.queue;                          // task waiting for destruction
 
-			if (tsk->join != DETACHED)                 // task not detached
+			if (tsk->join.queue != DETACHED)                 // task not detached
 			{
-				priv_mtx_remove(tsk);                  // release all owned robust mutexes
-				core_tsk_wakeup(tsk->join, E_DELETED); // notify waiting task
+				priv_mtx_remove(tsk);                        // release all owned robust mutexes
+				core_tsk_wakeup(tsk->join.queue, E_DELETED); // notify waiting task
 			}
 
-			priv_tsk_stop(tsk);                        // remove task from all queues
-			core_res_free(&tsk->hdr.obj.res);          // release resources
+			priv_tsk_stop(tsk);                              // remove task from all queues
+			core_slb_free(tsk_slb, &tsk->hdr.obj.res);       // release resources
 		}
 
-		IDLE.state = idle_tsk_default;                 // use default handler for idle process
+		IDLE.state = idle_tsk_default;                       // use default handler for idle process
 	}
 	sys_unlock();
 }
@@ -291,10 +359,10 @@ static
 void priv_tsk_destroy( void )
 /* -------------------------------------------------------------------------- */
 {
-	idle_tsk_destructor();                   // destroy all tasks waiting for destruction
+	idle_tsk_destructor();                         // destroy all tasks waiting for destruction
 
-	IDLE.state = idle_tsk_destructor;        // use destructor handler for idle process
-	core_tsk_waitFor(&System.des, INFINITE); // wait for destruction
+	IDLE.state = idle_tsk_destructor;              // use destructor handler for idle process
+	core_tsk_waitFor(&System.des.queue, INFINITE); // wait for destruction
 
 	assert(!"system cannot return here");
 }
@@ -316,17 +384,18 @@ void tsk_stop( void )
 	assert(System.cur->mtx.list == 0);
 
 	port_set_lock();
+	core_cri_enter();
 
-	priv_tsk_reset(System.cur);                   // reset necessary variables of current task
+	priv_tsk_reset(System.cur);                         // reset necessary variables of current task
 
-	if (System.cur->join == DETACHED)             // current task is detached
-		priv_tsk_destroy();                       // wait for destruction
+	if (System.cur->join.queue == DETACHED)             // current task is detached
+		priv_tsk_destroy();                             // wait for destruction
 
-	core_tsk_wakeup(System.cur->join, E_SUCCESS); // notify waiting task
-	core_tsk_remove(System.cur);                  // remove current task from ready queue
+	core_tsk_wakeup(System.cur->join.queue, E_SUCCESS); // notify waiting task
+	core_tsk_remove(System.cur);                        // remove current task from ready queue
 
 	assert(!"system cannot return here");
-	for (;;);                                     // disable unnecessary warning
+	for (;;);                                           // disable unnecessary warning
 }
 
 /* -------------------------------------------------------------------------- */
@@ -341,17 +410,17 @@ unsigned tsk_reset( tsk_t *tsk )
 
 	sys_lock();
 	{
-		if (tsk->join == DETACHED)                     // detached task cannot be reseted
+		if (tsk->join.queue == DETACHED)                     // detached task cannot be reseted
 			event = E_FAILURE;
 		else
 		{
-			priv_tsk_reset(tsk);                       // reset necessary task variables
+			priv_tsk_reset(tsk);                             // reset necessary task variables
 
-			if (tsk->hdr.id != ID_STOPPED)             // inactive task cannot be removed
+			if (tsk->hdr.id != ID_STOPPED)                   // inactive task cannot be removed
 			{
-				priv_mtx_remove(tsk);                  // release all owned robust mutexes
-				core_tsk_wakeup(tsk->join, E_STOPPED); // notify waiting task
-				priv_tsk_stop(tsk);                    // remove task from all queues
+				priv_mtx_remove(tsk);                        // release all owned robust mutexes
+				core_tsk_wakeup(tsk->join.queue, E_STOPPED); // notify waiting task
+				priv_tsk_stop(tsk);                          // remove task from all queues
 			}
 
 			event = E_SUCCESS;
@@ -374,23 +443,23 @@ unsigned tsk_destroy( tsk_t *tsk )
 
 	sys_lock();
 	{
-		if (tsk->join == DETACHED)                     // detached task cannot be deleted
+		if (tsk->join.queue == DETACHED)                     // detached task cannot be deleted
 			event = E_FAILURE;
 		else
 		{
-			priv_tsk_reset(tsk);                       // reset necessary task variables
+			priv_tsk_reset(tsk);                             // reset necessary task variables
 
-			if (tsk == System.cur)                     // current task will be destroyed by destructor
-				priv_tsk_destroy();                    // wait for destruction
+			if (tsk == System.cur)                           // current task will be destroyed by destructor
+				priv_tsk_destroy();                          // wait for destruction
 
-			if (tsk->hdr.id != ID_STOPPED)             // only active task can be removed
+			if (tsk->hdr.id != ID_STOPPED)                   // only active task can be removed
 			{
-				priv_mtx_remove(tsk);                  // release all owned robust mutexes
-				core_tsk_wakeup(tsk->join, E_DELETED); // notify waiting task             
-				priv_tsk_stop(tsk);                    // remove task from all queues     
+				priv_mtx_remove(tsk);                        // release all owned robust mutexes
+				core_tsk_wakeup(tsk->join.queue, E_DELETED); // notify waiting task
+				priv_tsk_stop(tsk);                          // remove task from all queues
 			}
 
-			core_res_free(&tsk->hdr.obj.res);          // release resources
+			core_slb_free(tsk_slb, &tsk->hdr.obj.res);       // release resources
 			event = E_SUCCESS;
 		}
 	}
@@ -420,6 +489,7 @@ void tsk_flip( fun_t *state )
 	assert(state);
 
 	port_set_lock();
+	core_cri_enter();
 
 	System.cur->state = state;
 
@@ -438,7 +508,7 @@ void tsk_setPrio( unsigned prio )
 
 	sys_lock();
 	{
-		System.cur->basic = prio;
+		System.cur->basic = _TSK_PRIO(prio);
 		core_cur_prio(prio);
 	}
 	sys_unlock();
@@ -467,7 +537,7 @@ void tsk_sleepFor( cnt_t delay )
 {
 	sys_lock();
 	{
-		core_tsk_waitFor(&System.dly, delay);
+		core_tsk_waitFor(&System.dly.queue, delay);
 	}
 	sys_unlock();
 }
@@ -478,7 +548,7 @@ void tsk_sleepNext( cnt_t delay )
 {
 	sys_lock();
 	{
-		core_tsk_waitNext(&System.dly, delay);
+		core_tsk_waitNext(&System.dly.queue, delay);
 	}
 	sys_unlock();
 }
@@ -489,7 +559,7 @@ void tsk_sleepUntil( cnt_t time )
 {
 	sys_lock();
 	{
-		core_tsk_waitUntil(&System.dly, time);
+		core_tsk_waitUntil(&System.dly.queue, time);
 	}
 	sys_unlock();
 }
@@ -505,6 +575,11 @@ unsigned tsk_suspend( tsk_t *tsk )
 
 	sys_lock();
 	{
+#if OS_STACK_SHARED
+		if (tsk != System.cur && tsk->shr.mode && !tsk->shr.init) // the task holds the frame on the shared stack
+			event = E_FAILURE;
+		else
+#endif
 		if (tsk->hdr.id == ID_READY && tsk->guard == 0)
 		{
 			core_tsk_suspend(tsk);
@@ -529,7 +604,7 @@ unsigned tsk_resume( tsk_t *tsk )
 
 	sys_lock();
 	{
-		if (tsk->guard == &System.dly && tsk->delay == INFINITE)
+		if (tsk->guard == &System.dly.queue && tsk->delay == INFINITE)
 		{
 			core_tsk_wakeup(tsk, 0); // ignored event value
 			event = E_SUCCESS;
@@ -557,6 +632,7 @@ void priv_sig_handler( tsk_t *tsk )
 		sigset &= -sigset;
 		tsk->sig.sigset &= ~sigset;
 
+		core_cri_leave();
 		port_clr_lock();
 		{
 			if (action)
@@ -566,6 +642,7 @@ void priv_sig_handler( tsk_t *tsk )
 			}
 		}
 		port_set_lock();
+		core_cri_enter();
 	}
 }
 
@@ -577,6 +654,7 @@ void priv_sig_deliver( void )
 	tsk_t *tsk = System.cur;
 
 	port_set_lock();
+	core_cri_enter();
 
 	priv_sig_handler(tsk);
 
@@ -657,3 +735,55 @@ void tsk_action( tsk_t *tsk, act_t *action )
 }
 
 /* -------------------------------------------------------------------------- */
+#if OS_TASK_STATS
+void tsk_stats( tsk_t *tsk, tst_t *stats )
+/* -------------------------------------------------------------------------- */
+{
+	cyc_t run;
+
+	assert(tsk);
+	assert(stats);
+
+	sys_lock();
+	{
+		stats->time     = tsk->stat.time;
+		stats->max      = tsk->stat.max;
+		stats->switches = tsk->stat.switches;
+		stats->preempts = tsk->stat.preempts;
+
+		if (tsk == System.cur)
+		{
+			run = (cyc_t)(core_cyc_time() - tsk->stat.start);
+			stats->time += run;
+			if (stats->max < run)
+				stats->max = run;
+		}
+	}
+	sys_unlock();
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
+#if OS_STACK_SCAN
+unsigned tsk_stackUsed( tsk_t *tsk )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned used = 0;
+
+	assert(tsk);
+
+	sys_lock();
+	{
+#if OS_STACK_SHARED
+		if (!tsk->shr.mode)
+#endif
+		if (tsk != &MAIN && tsk != &IDLE)
+			used = tsk->size - tsk->stk.free * sizeof(stk_t);
+	}
+	sys_unlock();
+
+	return used;
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
@@ -33,6 +33,14 @@
 #include "inc/oscriticalsection.h"
 #include "osalloc.h"
 
+/* -------------------------------------------------------------------------- */
+
+#if OS_SLAB_TMR
+OS_SLB(tmr_slb, tmr_t, OS_SLAB_TMR);
+#else
+#define tmr_slb NULL
+#endif
+
 /* -------------------------------------------------------------------------- */
 static
 void priv_tmr_init( tmr_t *tmr, fun_t *state )
@@ -68,7 +76,7 @@ tmr_t *tmr_create( fun_t *state )
 
 	sys_lock();
 	{
-		tmr = sys_alloc(sizeof(tmr_t));
+		tmr = core_slb_alloc(tmr_slb, sizeof(tmr_t));
 		priv_tmr_init(tmr, state);
 		tmr->hdr.obj.res = tmr;
 	}
@@ -82,11 +90,15 @@ static
 void priv_tmr_reset( tmr_t *tmr, unsigned event )
 /* -------------------------------------------------------------------------- */
 {
+	core_tmr_cancel(tmr);
+
 	if (tmr->hdr.id == ID_TIMER)
 	{
 		core_all_wakeup(tmr->hdr.obj.queue, event);
 		core_tmr_remove(tmr);
 	}
+
+	core_obj_reset(&tmr->hdr.obj);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -115,7 +127,7 @@ void tmr_destroy( tmr_t *tmr )
 	sys_lock();
 	{
 		priv_tmr_reset(tmr, tmr->hdr.obj.res ? E_DELETED : E_STOPPED);
-		core_res_free(&tmr->hdr.obj.res);
+		core_slb_free(tmr_slb, &tmr->hdr.obj.res);
 	}
 	sys_unlock();
 }
@@ -212,6 +224,8 @@ static
 unsigned priv_tmr_take( tmr_t *tmr )
 /* -------------------------------------------------------------------------- */
 {
+	core_obj_event(TRC_TAKE, tmr);
+
 	if (tmr->hdr.next == 0)
 		return E_FAILURE; // timer has not yet been started
 
@@ -306,3 +320,24 @@ unsigned tmr_waitUntil( tmr_t *tmr, cnt_t time )
 }
 
 /* -------------------------------------------------------------------------- */
+void tmr_setMode( tmr_t *tmr, unsigned mode )
+/* -------------------------------------------------------------------------- */
+{
+	assert_tsk_context();
+	assert(tmr);
+	assert(tmr->hdr.obj.res!=RELEASED);
+	assert(mode==tmrISR || mode==tmrDaemon);
+
+#if OS_TIMER_DAEMON
+	sys_lock();
+	{
+		tmr->dmn.mode = mode;
+	}
+	sys_unlock();
+#else
+	(void) tmr;
+	(void) mode;
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
@@ -136,6 +136,22 @@ void port_sys_init( void )
 
 #endif//HW_TIMER_SIZE
 
+#if OS_TASK_STATS || OS_OBJECT_STATS || OS_TRACE_SIZE || OS_LOCK_PROFILE
+
+/******************************************************************************
+ Configuration of cycle counter for the task statistics and the kernel trace
+*******************************************************************************/
+
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT   = 0U;
+	DWT->CTRL    |= DWT_CTRL_CYCCNTENA_Msk;
+
+/******************************************************************************
+ End of configuration
+*******************************************************************************/
+
+#endif//OS_TASK_STATS || OS_OBJECT_STATS || OS_TRACE_SIZE || OS_LOCK_PROFILE
+
 /******************************************************************************
  Configuration of interrupt for context switch
 *******************************************************************************/
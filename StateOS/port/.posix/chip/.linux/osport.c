@@ -0,0 +1,247 @@
+/******************************************************************************
+
+    @file    StateOS: osport.c
+    @author  Rajmund Szymanski
+    @date    16.10.2026
+    @brief   StateOS port file for POSIX host.
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include "oskernel.h"
+#include "inc/ostask.h"
+
+/* -------------------------------------------------------------------------- */
+
+volatile int port_lck = 0;
+volatile int port_isr = 0;
+volatile int port_pnd = 0;
+
+static timer_t SysTimer;
+#if HW_TIMER_SIZE && OS_ROBIN
+static timer_t SysTick;
+#endif
+
+void port_ctx_pendsv( void );
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_tmr_create( timer_t *timer, int irq )
+{
+	struct sigevent sev = { 0 };
+
+	sev.sigev_notify = SIGEV_SIGNAL;
+	sev.sigev_signo  = SIGALRM;
+	sev.sigev_value.sival_int = irq;
+
+	if (timer_create(CLOCK_MONOTONIC, &sev, timer) != 0)
+		abort();
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_tmr_period( timer_t timer, long frequency )
+{
+	struct itimerspec its = { { 0, 0 }, { 0, 0 } };
+
+	its.it_interval.tv_sec  = 1 / frequency;
+	its.it_interval.tv_nsec = 1000000000L / frequency % 1000000000L;
+	its.it_value = its.it_interval;
+
+	timer_settime(timer, 0, &its, 0);
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_sig_handler( int signo, siginfo_t *info, void *uc )
+{
+	int err = errno;
+	(void) signo;
+	(void) uc;
+
+	port_isr_pending(info->si_value.sival_int);
+	if (port_lck == 0 && port_isr == 0)
+		port_isr_service();
+
+	errno = err;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void port_sys_init( void )
+{
+	static bool init = false;
+	struct sigaction sa = { 0 };
+
+/******************************************************************************
+ Make sure that the system timer has not yet been initialized
+ This is only needed for compilers supporting the "constructor" function attribute or its equivalent
+*******************************************************************************/
+
+	if (init) return;
+	init = true;
+
+/******************************************************************************
+ End of check
+*******************************************************************************/
+
+	port_ctx_init(IDLE.sp, core_tsk_loop);
+
+	sa.sa_sigaction = priv_sig_handler;
+	sa.sa_flags = SA_SIGINFO | SA_RESTART;
+	sigemptyset(&sa.sa_mask);
+	sigaction(SIGALRM, &sa, 0);
+
+	priv_tmr_create(&SysTimer, PORT_SYSTIM);
+
+#if HW_TIMER_SIZE == 0
+
+/******************************************************************************
+ Non-tick-less mode: configuration of system timer
+ It must generate interrupts with frequency OS_FREQUENCY
+*******************************************************************************/
+
+	priv_tmr_period(SysTimer, OS_FREQUENCY);
+
+/******************************************************************************
+ End of configuration
+*******************************************************************************/
+
+#else //HW_TIMER_SIZE
+
+	#if OS_ROBIN
+
+/******************************************************************************
+ Tick-less mode with preemption: configuration of timer for context switch triggering
+ It must generate interrupts with frequency OS_ROBIN
+*******************************************************************************/
+
+	priv_tmr_create(&SysTick, PORT_SYSTICK);
+	priv_tmr_period(SysTick, OS_ROBIN);
+
+/******************************************************************************
+ End of configuration
+*******************************************************************************/
+
+	#endif//OS_ROBIN
+
+#endif//HW_TIMER_SIZE
+}
+
+/* -------------------------------------------------------------------------- */
+// interrupt handlers are served in order of priority,
+// the context switch has the lowest priority
+
+void port_isr_service( void )
+{
+	int pnd;
+
+	port_isr++;
+
+	for (;;)
+	{
+		pnd = __atomic_fetch_and(&port_pnd, PORT_PENDSV, __ATOMIC_SEQ_CST) & ~PORT_PENDSV;
+
+		if (pnd & PORT_SYSTIM)
+		{
+#if HW_TIMER_SIZE == 0
+			core_sys_tick();
+#else
+			core_tmr_handler();
+#endif
+		}
+#if HW_TIMER_SIZE && OS_ROBIN
+		if (pnd & PORT_SYSTICK)
+		{
+			core_ctx_switch();
+		}
+#endif
+		if (pnd)
+			continue;
+
+		if (__atomic_fetch_and(&port_pnd, ~PORT_PENDSV, __ATOMIC_SEQ_CST) & PORT_PENDSV)
+		{
+			port_ctx_pendsv();
+			continue;
+		}
+
+		break;
+	}
+
+	port_isr--;
+}
+
+/* -------------------------------------------------------------------------- */
+
+#if HW_TIMER_SIZE
+
+/******************************************************************************
+ Tick-less mode: time breakpoint of system timer
+*******************************************************************************/
+
+void port_tmr_stop( void )
+{
+	struct itimerspec its = { { 0, 0 }, { 0, 0 } };
+
+	timer_settime(SysTimer, 0, &its, 0);
+}
+
+void port_tmr_start( uint64_t timeout )
+{
+	struct itimerspec its = { { 0, 0 }, { 0, 0 } };
+	cnt_t delay = (cnt_t)((cnt_t)timeout - (cnt_t)port_sys_time());
+
+	if (delay == 0 || delay > ((CNT_MAX)>>1))
+		delay = 1;
+
+	its.it_value.tv_sec  = delay / (OS_FREQUENCY);
+	its.it_value.tv_nsec = (long)((uint64_t)(delay % (OS_FREQUENCY)) * 1000000000U / (OS_FREQUENCY));
+	if (its.it_value.tv_sec == 0 && its.it_value.tv_nsec == 0)
+		its.it_value.tv_nsec = 1;
+
+	timer_settime(SysTimer, 0, &its, 0);
+}
+
+	#if OS_ROBIN
+
+void port_ctx_reset( void )
+{
+	priv_tmr_period(SysTick, OS_ROBIN);
+}
+
+	#endif//OS_ROBIN
+
+/******************************************************************************
+ End of the time breakpoint
+*******************************************************************************/
+
+#endif//HW_TIMER_SIZE
+
+/* -------------------------------------------------------------------------- */
@@ -0,0 +1,208 @@
+/******************************************************************************
+
+    @file    StateOS: osport.h
+    @author  Rajmund Szymanski
+    @date    16.10.2026
+    @brief   StateOS port file for POSIX host.
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+#ifndef __STATEOSPORT_H
+#define __STATEOSPORT_H
+
+#include <stdint.h>
+#include <time.h>
+#ifndef   NOCONFIG
+#include "osconfig.h"
+#endif
+#include "osdefs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_FREQUENCY
+#define OS_FREQUENCY       1000 /* Hz */
+#endif
+
+#if     OS_FREQUENCY > 1000000000
+#error  osconfig.h: Incorrect OS_FREQUENCY value!
+#endif
+
+/* -------------------------------------------------------------------------- */
+// !! WARNING! OS_TIMER_SIZE < HW_TIMER_SIZE may cause unexpected problems !!
+
+#ifndef OS_TIMER_SIZE
+#define OS_TIMER_SIZE        32 /* bit size of system timer counter           */
+#endif
+
+/* -------------------------------------------------------------------------- */
+// the host monotonic clock is used as the hardware timer in tick-less mode
+
+#ifdef  HW_TIMER_SIZE
+#error  HW_TIMER_SIZE is an internal os definition!
+#elif   OS_FREQUENCY > 1000
+#define HW_TIMER_SIZE  OS_TIMER_SIZE /* bit size of hardware timer            */
+#else
+#define HW_TIMER_SIZE         0 /* os does not work in tick-less mode         */
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_ROBIN
+#define OS_ROBIN              0 /* system works in cooperative mode           */
+#endif
+
+#if     OS_ROBIN > OS_FREQUENCY
+#error  osconfig.h: Incorrect OS_ROBIN value!
+#endif
+
+/* -------------------------------------------------------------------------- */
+// emulated interrupt controller
+// the host timer signals are the interrupt requests of the system
+
+#define PORT_PENDSV  (1U << 0) // context switch request
+#define PORT_SYSTIM  (1U << 1) // system timer interrupt request
+#define PORT_SYSTICK (1U << 2) // round robin timer interrupt request (tick-less mode)
+
+extern volatile int port_lck; // interrupts masked
+extern volatile int port_isr; // interrupt nesting level
+extern volatile int port_pnd; // pending interrupt requests
+
+// service all pending interrupt requests
+void port_isr_service( void );
+
+// raise the interrupt request
+__STATIC_INLINE
+void port_isr_pending( int irq )
+{
+	__atomic_or_fetch(&port_pnd, irq, __ATOMIC_SEQ_CST);
+}
+
+/* -------------------------------------------------------------------------- */
+// return current system time
+
+#if HW_TIMER_SIZE >= OS_TIMER_SIZE
+
+__STATIC_INLINE
+uint64_t port_sys_time( void )
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * (OS_FREQUENCY) + (uint64_t)ts.tv_nsec * (OS_FREQUENCY) / 1000000000U;
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+// return current value of the cycle counter (used by the task statistics)
+// the monotonic clock in nanoseconds
+
+#define PORT_CYC_FREQUENCY 1000000000 /* Hz */
+
+__STATIC_INLINE
+uint64_t port_cyc_time( void )
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000U + (uint64_t)ts.tv_nsec;
+}
+
+/* -------------------------------------------------------------------------- */
+// force yield system control to the next process
+
+__STATIC_INLINE
+void port_ctx_switch( void )
+{
+	port_isr_pending(PORT_PENDSV);
+}
+
+/* -------------------------------------------------------------------------- */
+// the context has been switched
+
+__STATIC_INLINE
+void port_ctx_switched( void )
+{
+}
+
+/* -------------------------------------------------------------------------- */
+// reset context switch indicator
+
+#if HW_TIMER_SIZE && OS_ROBIN
+void port_ctx_reset( void );
+#else
+__STATIC_INLINE
+void port_ctx_reset( void )
+{
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
+// clear time breakpoint
+
+#if HW_TIMER_SIZE
+void port_tmr_stop( void );
+#else
+__STATIC_INLINE
+void port_tmr_stop( void )
+{
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
+// set time breakpoint
+
+#if HW_TIMER_SIZE
+void port_tmr_start( uint64_t timeout );
+#else
+__STATIC_INLINE
+void port_tmr_start( uint64_t timeout )
+{
+	(void) timeout;
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
+// force timer interrupt
+
+__STATIC_INLINE
+void port_tmr_force( void )
+{
+#if HW_TIMER_SIZE
+	port_isr_pending(PORT_SYSTIM);
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+
+#ifdef __cplusplus
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#endif//__STATEOSPORT_H
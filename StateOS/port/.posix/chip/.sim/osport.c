@@ -0,0 +1,254 @@
+/******************************************************************************
+
+    @file    StateOS: osport.c
+    @author  Rajmund Szymanski
+    @date    16.10.2026
+    @brief   StateOS port file for POSIX host (virtual-time simulator).
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "oskernel.h"
+#include "inc/ostask.h"
+
+/* -------------------------------------------------------------------------- */
+
+volatile int port_lck = 0;
+volatile int port_isr = 0;
+volatile int port_pnd = 0;
+
+sim_t port_sim = { 0 };
+
+static uint64_t          Alarm;        // time breakpoint of the system timer
+static bool              Armed = false;// time breakpoint is set
+#if OS_ROBIN
+static uint64_t          Robin;        // time of the next round robin interrupt
+#endif
+static const sim_isr_t * Script = 0;   // script of the interrupts
+static unsigned          Count  = 0;   // number of the interrupts in the script
+static unsigned          Next   = 0;   // next interrupt of the script
+
+void port_ctx_pendsv( void );
+
+/* -------------------------------------------------------------------------- */
+// raise the interrupt requests of all events that have occurred
+
+static
+void priv_sim_check( void )
+{
+	if (Armed && Alarm <= port_sim.time)
+	{
+		Armed = false;
+		port_isr_pending(PORT_SYSTIM);
+	}
+#if OS_ROBIN
+	if (Robin <= port_sim.time)
+	{
+		Robin = port_sim.time + (OS_FREQUENCY)/(OS_ROBIN);
+		port_isr_pending(PORT_SYSTICK);
+	}
+#endif
+	if (Next < Count && Script[Next].time <= port_sim.time)
+	{
+		port_isr_pending(PORT_SCRIPT);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void port_sys_init( void )
+{
+	static bool init = false;
+
+/******************************************************************************
+ Make sure that the system timer has not yet been initialized
+ This is only needed for compilers supporting the "constructor" function attribute or its equivalent
+*******************************************************************************/
+
+	if (init) return;
+	init = true;
+
+/******************************************************************************
+ End of check
+*******************************************************************************/
+
+	port_ctx_init(IDLE.sp, core_tsk_loop);
+
+#if OS_ROBIN
+	Robin = (OS_FREQUENCY)/(OS_ROBIN);
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+
+void port_sim_script( const sim_isr_t *script, unsigned count )
+{
+	port_set_lock();
+
+	Script = script;
+	Count  = count;
+	Next   = 0;
+
+	while (Next < Count && Script[Next].time < port_sim.time)
+		Next++;
+
+	priv_sim_check();
+
+	port_clr_lock();
+}
+
+/* -------------------------------------------------------------------------- */
+// there is no ready task: jump to the next event of the simulation
+// the simulation ends when there are no more events:
+// successfully if the main task has finished, otherwise the system is deadlocked
+
+void port_sim_idle( void )
+{
+	uint64_t time = UINT64_MAX;
+
+	port_set_lock();
+
+	if (Armed)
+		time = Alarm;
+	if (Next < Count && Script[Next].time < time)
+		time = Script[Next].time;
+	if (time == UINT64_MAX)
+	{
+		if (MAIN.hdr.id == ID_STOPPED)
+			exit(EXIT_SUCCESS);
+		fputs("simulation deadlock: no ready task and no pending event\n", stderr);
+		exit(EXIT_FAILURE);
+	}
+
+	if (port_sim.time < time)
+	{
+		port_sim.time = time;
+		port_sim.idle++;
+	}
+
+	priv_sim_check();
+
+	port_clr_lock();
+}
+
+/* -------------------------------------------------------------------------- */
+
+uint64_t port_sys_time( void )
+{
+#if OS_SIM_STEP
+	port_sim.time += OS_SIM_STEP;
+	priv_sim_check();
+#endif
+	return port_sim.time;
+}
+
+/* -------------------------------------------------------------------------- */
+// interrupt handlers are served in order of priority,
+// the context switch has the lowest priority
+
+void port_isr_service( void )
+{
+	int pnd;
+
+	port_isr++;
+
+	for (;;)
+	{
+		pnd = port_pnd & ~PORT_PENDSV;
+		port_pnd &= PORT_PENDSV;
+
+		if (pnd & PORT_SYSTIM)
+		{
+			port_sim.tmr++;
+			core_tmr_handler();
+		}
+#if OS_ROBIN
+		if (pnd & PORT_SYSTICK)
+		{
+			core_ctx_switch();
+		}
+#endif
+		if (pnd & PORT_SCRIPT)
+		{
+			while (Next < Count && Script[Next].time <= port_sim.time)
+			{
+				port_sim.isr++;
+				Script[Next++].isr();
+			}
+		}
+		if (pnd)
+			continue;
+
+		if (port_pnd & PORT_PENDSV)
+		{
+			port_pnd &= ~PORT_PENDSV;
+			port_ctx_pendsv();
+			continue;
+		}
+
+		break;
+	}
+
+	port_isr--;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/******************************************************************************
+ Tick-less mode: time breakpoint of system timer
+*******************************************************************************/
+
+void port_tmr_stop( void )
+{
+	Armed = false;
+}
+
+void port_tmr_start( uint64_t timeout )
+{
+	cnt_t delay = (cnt_t)((cnt_t)timeout - (cnt_t)port_sim.time);
+
+	if (delay > ((CNT_MAX)>>1))
+		delay = 0;
+
+	Alarm = port_sim.time + delay;
+	Armed = true;
+}
+
+#if OS_ROBIN
+
+void port_ctx_reset( void )
+{
+	Robin = port_sim.time + (OS_FREQUENCY)/(OS_ROBIN);
+}
+
+#endif//OS_ROBIN
+
+/******************************************************************************
+ End of the time breakpoint
+*******************************************************************************/
+
+/* -------------------------------------------------------------------------- */
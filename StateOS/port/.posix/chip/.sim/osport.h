@@ -0,0 +1,241 @@
+/******************************************************************************
+
+    @file    StateOS: osport.h
+    @author  Rajmund Szymanski
+    @date    16.10.2026
+    @brief   StateOS port file for POSIX host (virtual-time simulator).
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+
+#ifndef __STATEOSPORT_H
+#define __STATEOSPORT_H
+
+#include <stdint.h>
+#ifndef   NOCONFIG
+#include "osconfig.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* -------------------------------------------------------------------------- */
+// the idle task advances the virtual clock to the next event of the simulation
+
+void port_sim_idle( void );
+
+#ifndef __WFI
+#define __WFI()             port_sim_idle()
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#include "osdefs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_FREQUENCY
+#define OS_FREQUENCY    1000000 /* Hz */
+#endif
+
+#if     OS_FREQUENCY > 1000000000
+#error  osconfig.h: Incorrect OS_FREQUENCY value!
+#endif
+
+/* -------------------------------------------------------------------------- */
+// !! WARNING! OS_TIMER_SIZE < HW_TIMER_SIZE may cause unexpected problems !!
+
+#ifndef OS_TIMER_SIZE
+#define OS_TIMER_SIZE        32 /* bit size of system timer counter           */
+#endif
+
+/* -------------------------------------------------------------------------- */
+// the virtual clock is used as the hardware timer, the simulator works only in tick-less mode
+
+#ifdef  HW_TIMER_SIZE
+#error  HW_TIMER_SIZE is an internal os definition!
+#else
+#define HW_TIMER_SIZE  OS_TIMER_SIZE /* bit size of hardware timer            */
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_ROBIN
+#define OS_ROBIN              0 /* system works in cooperative mode           */
+#endif
+
+#if     OS_ROBIN > OS_FREQUENCY
+#error  osconfig.h: Incorrect OS_ROBIN value!
+#endif
+
+/* -------------------------------------------------------------------------- */
+// the simulator does not preempt a task that never reads the clock and never blocks,
+// such tasks (infinite loops) hang the simulation
+
+#define PORT_SIMULATOR        1
+
+/* -------------------------------------------------------------------------- */
+// number of ticks the virtual clock advances with every reading
+// 0 => time stands still while the tasks are running, it is advanced only by the idle task
+
+#ifndef OS_SIM_STEP
+#define OS_SIM_STEP           0
+#endif
+
+/* -------------------------------------------------------------------------- */
+// emulated interrupt controller
+// the events of the simulation are the interrupt requests of the system
+
+#define PORT_PENDSV  (1U << 0) // context switch request
+#define PORT_SYSTIM  (1U << 1) // system timer interrupt request
+#define PORT_SYSTICK (1U << 2) // round robin timer interrupt request
+#define PORT_SCRIPT  (1U << 3) // scripted interrupt request
+
+extern volatile int port_lck; // interrupts masked
+extern volatile int port_isr; // interrupt nesting level
+extern volatile int port_pnd; // pending interrupt requests
+
+// service all pending interrupt requests
+void port_isr_service( void );
+
+// raise the interrupt request
+__STATIC_INLINE
+void port_isr_pending( int irq )
+{
+	port_pnd = port_pnd | irq;
+}
+
+/* -------------------------------------------------------------------------- */
+// scripted interrupt: handler 'isr' is executed at virtual time 'time'
+// the script must be sorted by time
+
+typedef struct __sim_isr
+{
+	uint64_t time;  // virtual time of the interrupt
+	void   (*isr)( void ); // interrupt handler
+
+}	sim_isr_t;
+
+// set the script of the interrupts
+void port_sim_script( const sim_isr_t *script, unsigned count );
+
+/* -------------------------------------------------------------------------- */
+// counters of the simulation events
+// they do not depend on the host, so the results of the simulation are reproducible
+
+typedef struct __sim
+{
+	uint64_t time;  // virtual clock
+	uint64_t idle;  // number of jumps of the virtual clock to the next event
+	uint64_t tmr;   // number of system timer interrupts
+	uint64_t isr;   // number of scripted interrupts
+	uint64_t ctx;   // number of context switches
+
+}	sim_t;
+
+extern sim_t port_sim;
+
+/* -------------------------------------------------------------------------- */
+// return current system time
+
+uint64_t port_sys_time( void );
+
+/* -------------------------------------------------------------------------- */
+// return current value of the cycle counter (used by the task statistics)
+// the virtual clock, it is read without advancing
+
+#define PORT_CYC_FREQUENCY OS_FREQUENCY
+
+__STATIC_INLINE
+uint64_t port_cyc_time( void )
+{
+	return port_sim.time;
+}
+
+/* -------------------------------------------------------------------------- */
+// force yield system control to the next process
+
+__STATIC_INLINE
+void port_ctx_switch( void )
+{
+	port_isr_pending(PORT_PENDSV);
+}
+
+/* -------------------------------------------------------------------------- */
+// the context has been switched
+
+__STATIC_INLINE
+void port_ctx_switched( void )
+{
+	port_sim.ctx++;
+}
+
+/* -------------------------------------------------------------------------- */
+// reset context switch indicator
+
+#if OS_ROBIN
+void port_ctx_reset( void );
+#else
+__STATIC_INLINE
+void port_ctx_reset( void )
+{
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
+// clear time breakpoint
+
+void port_tmr_stop( void );
+
+/* -------------------------------------------------------------------------- */
+// set time breakpoint
+
+void port_tmr_start( uint64_t timeout );
+
+/* -------------------------------------------------------------------------- */
+// force timer interrupt
+
+__STATIC_INLINE
+void port_tmr_force( void )
+{
+	port_isr_pending(PORT_SYSTIM);
+}
+
+/* -------------------------------------------------------------------------- */
+
+#ifdef __cplusplus
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#endif//__STATEOSPORT_H
@@ -0,0 +1,164 @@
+/******************************************************************************
+
+    @file    StateOS: oscore.c
+    @author  Rajmund Szymanski
+    @date    16.10.2026
+    @brief   StateOS port file for POSIX host.
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <signal.h>
+#include <ucontext.h>
+#include "oskernel.h"
+#include "inc/ostask.h"
+
+/* -------------------------------------------------------------------------- */
+// host fiber: host stack and machine state of the task context
+
+typedef struct __fib fib_t;
+
+struct __fib
+{
+	fib_t    * next; // next fiber in the registry
+	ctx_t    * ctx;  // task context bound to the fiber (0: free fiber)
+	ucontext_t uc;   // saved machine state
+	stk_t      stk[];// host stack
+};
+
+/* -------------------------------------------------------------------------- */
+
+static fib_t   MAIN_FIB;
+static ctx_t   MAIN_CTX = { .fib=&MAIN_FIB };
+static fib_t   MAIN_FIB = { .ctx=&MAIN_CTX };
+static fib_t * Fibers   = 0;        // registry of allocated fibers
+static fib_t * Running  = &MAIN_FIB;// fiber of the current task
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_fib_entry( void )
+{
+	port_isr = 0;
+	port_lck = 1;
+	Running->ctx->pc();
+	abort();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void port_ctx_init( ctx_t *ctx, fun_t *pc )
+{
+	fib_t *fib;
+	fib_t *tmp = 0;
+
+	for (fib = Fibers; fib; fib = fib->next)
+	{
+		if (fib == Running)
+			continue;
+		if (fib->ctx == ctx)
+		{
+			tmp = fib; // reuse fiber previously bound to the context
+			break;
+		}
+		if (fib->ctx == 0 && tmp == 0)
+			tmp = fib; // first free fiber
+	}
+
+	if (tmp == 0)
+	{
+		tmp = malloc(sizeof(fib_t) + OS_HOST_STACK);
+		assert(tmp);
+		tmp->next = Fibers;
+		Fibers = tmp;
+	}
+
+	getcontext(&tmp->uc);
+	tmp->uc.uc_stack.ss_sp   = tmp->stk;
+	tmp->uc.uc_stack.ss_size = OS_HOST_STACK;
+	tmp->uc.uc_link = 0;
+	sigemptyset(&tmp->uc.uc_sigmask);
+	makecontext(&tmp->uc, priv_fib_entry, 0);
+
+	tmp->ctx = ctx;
+	ctx->pc  = pc;
+	ctx->fib = tmp;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void *port_get_sp( void )
+{
+	return Running->ctx;
+}
+
+/* -------------------------------------------------------------------------- */
+// context switch, the equivalent of PendSV_Handler
+// called from port_isr_service with interrupts enabled
+
+void port_ctx_pendsv( void )
+{
+	fib_t *cur  = Running;
+	fib_t *nxt;
+	ctx_t *ctx;
+	lck_t  isr  = port_isr;
+	bool   keep = System.cur->hdr.id != ID_STOPPED;
+
+	ctx = core_tsk_handler(cur->ctx);
+	if (ctx == cur->ctx && ctx->fib == cur) // the context of the task dispatched on the shared stack may have the same address
+		return;
+
+	nxt = ctx->fib;
+	assert(nxt && nxt->ctx == ctx);
+
+	if (!keep && cur != &MAIN_FIB)
+		cur->ctx = 0; // the task has been stopped, release its fiber
+
+	port_ctx_switched();
+
+	Running = nxt;
+	swapcontext(&cur->uc, &nxt->uc);
+
+	port_isr = isr;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void core_tsk_flip( void *sp )
+{
+	fib_t *cur = Running;
+	ctx_t *ctx = (ctx_t *)sp - 1;
+
+	port_ctx_init(ctx, core_tsk_loop);
+
+	if (cur != &MAIN_FIB)
+		cur->ctx = 0;
+
+	Running = ctx->fib;
+	setcontext(&Running->uc);
+	abort();
+}
+
+/* -------------------------------------------------------------------------- */
@@ -0,0 +1,173 @@
+/******************************************************************************
+
+    @file    StateOS: oscore.h
+    @author  Rajmund Szymanski
+    @date    16.10.2026
+    @brief   StateOS port file for POSIX host.
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+#ifndef __STATEOSCORE_H
+#define __STATEOSCORE_H
+
+#include "osbase.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_HEAP_SIZE
+#define OS_HEAP_SIZE          0 /* default system heap: all free memory       */
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_STACK_SIZE
+#define OS_STACK_SIZE       256 /* default task stack size in bytes           */
+#endif
+
+#ifndef OS_IDLE_STACK
+#define OS_IDLE_STACK       128 /* idle task stack size in bytes              */
+#endif
+
+/* -------------------------------------------------------------------------- */
+// tasks are executed on host stacks allocated by the port,
+// the task stack keeps only the task context
+
+#ifndef OS_HOST_STACK
+#define OS_HOST_STACK     65536 /* host stack size in bytes for every task    */
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_LOCK_LEVEL
+#define OS_LOCK_LEVEL         0 /* critical section blocks all interrupts     */
+#endif
+
+#if     OS_LOCK_LEVEL
+#error  osconfig.h: Incorrect OS_LOCK_LEVEL value! Must be 0.
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_MAIN_PRIO
+#define OS_MAIN_PRIO          0 /* priority of main process                   */
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_FUNCTIONAL
+#define OS_FUNCTIONAL         4
+#elif   OS_FUNCTIONAL
+#error  OS_FUNCTIONAL is an internal port definition!
+#endif//OS_FUNCTIONAL
+
+/* -------------------------------------------------------------------------- */
+
+typedef int                   lck_t;
+typedef uint64_t              stk_t;
+
+/* -------------------------------------------------------------------------- */
+
+// task context
+typedef struct __ctx ctx_t;
+
+struct __ctx
+{
+	fun_t  * pc;  // entry point of the task
+	void   * fib; // host fiber bound to the context
+};
+
+#define _CTX_INIT( pc ) { pc, NULL }
+
+/* -------------------------------------------------------------------------- */
+// init task context
+// bind a host fiber to the context
+
+void port_ctx_init( ctx_t *ctx, fun_t *pc );
+
+/* -------------------------------------------------------------------------- */
+// is procedure inside ISR?
+
+__STATIC_INLINE
+bool port_isr_context( void )
+{
+	return (port_isr != 0);
+}
+
+/* -------------------------------------------------------------------------- */
+// are interrupts masked?
+
+__STATIC_INLINE
+bool port_isr_masked( void )
+{
+	return (port_lck != 0);
+}
+
+/* -------------------------------------------------------------------------- */
+// get current stack pointer
+
+void * port_get_sp( void );
+
+/* -------------------------------------------------------------------------- */
+
+__STATIC_INLINE
+lck_t port_get_lock( void )
+{
+	return port_lck;
+}
+
+__STATIC_INLINE
+void port_put_lock( lck_t lck )
+{
+	__COMPILER_BARRIER();
+	port_lck = lck;
+	__COMPILER_BARRIER();
+	if (lck == 0 && port_pnd != 0 && port_isr == 0)
+		port_isr_service();
+}
+
+__STATIC_INLINE
+void port_set_lock( void )
+{
+	port_lck = 1;
+	__COMPILER_BARRIER();
+}
+
+__STATIC_INLINE
+void port_clr_lock( void )
+{
+	port_put_lock(0);
+}
+
+/* -------------------------------------------------------------------------- */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif//__STATEOSCORE_H
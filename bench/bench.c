@@ -0,0 +1,73 @@
+#include "bench.h"
+
+// build and run on the host:
+// make -f makefile.host clean run DEFS=BENCH
+// results are printed as CSV: benchmark, size of payload, min, median and max duration of the operation
+
+#if defined(BENCH)
+
+static uint32_t sample[SAMPLES];
+
+static uint32_t bench_overhead( unsigned size )
+{
+	uint32_t t = BENCH_Now();
+	(void) size;
+	return BENCH_Now() - t;
+}
+
+void bench_run( const char *name, bench_t *bench, unsigned size )
+{
+	unsigned i, j;
+	uint32_t t;
+
+	for (i = 0; i < SAMPLES; i++)
+	{
+		t = bench(size);
+		for (j = i; j > 0 && sample[j - 1] > t; j--)
+			sample[j] = sample[j - 1];
+		sample[j] = t;
+	}
+
+	printf("%s,%u,%lu,%lu,%lu\n", name, size,
+		(unsigned long) sample[0], (unsigned long) sample[SAMPLES / 2], (unsigned long) sample[SAMPLES - 1]);
+}
+
+int main()
+{
+	BENCH_Init();
+
+	printf("# unit: %s, samples: %u\n", BENCH_UNIT, SAMPLES);
+	printf("# OS_FREQUENCY: %lu, OS_ROBIN: %lu, OS_TIMER_SIZE: %u, HW_TIMER_SIZE: %u, OS_PRIO_LEVELS: %u, OS_TIMER_WHEEL: %u\n",
+		(unsigned long)(OS_FREQUENCY), (unsigned long)(OS_ROBIN), OS_TIMER_SIZE, HW_TIMER_SIZE, OS_PRIO_LEVELS, OS_TIMER_WHEEL);
+	printf("benchmark,size,min,median,max\n");
+
+	bench_run("bench_overhead", bench_overhead, 0);
+
+	BENCH_Run(bench_sem_give_take, 0);
+	BENCH_Run(bench_sem_give_switch, 0);
+	BENCH_Run(bench_mtx_lock_unlock, 0);
+	BENCH_Run(bench_mtx_unlock_contended, 0);
+	BENCH_Run(bench_box_give_take, 4);
+	BENCH_Run(bench_box_give_take, 16);
+	BENCH_Run(bench_box_give_take, 64);
+	BENCH_Run(bench_evq_give_take, 4);
+	BENCH_Run(bench_msg_give_take, 4);
+	BENCH_Run(bench_msg_give_take, 16);
+	BENCH_Run(bench_msg_give_take, 64);
+	BENCH_Run(bench_stm_give_take, 4);
+	BENCH_Run(bench_stm_give_take, 16);
+	BENCH_Run(bench_stm_give_take, 64);
+	BENCH_Run(bench_tmr_start_stop, 0);
+	BENCH_Run(bench_tsk_yield, 0);
+	BENCH_Run(bench_mem_take_give, 0);
+	BENCH_Run(bench_sys_alloc_free, 16);
+	BENCH_Run(bench_sys_alloc_free, 64);
+
+#if defined(__unix__)
+	exit(EXIT_SUCCESS);
+#endif
+
+	tsk_stop();
+}
+
+#endif//BENCH
@@ -0,0 +1,85 @@
+#include <stm32f4_discovery.h>
+#include <os.h>
+#include <stdio.h>
+
+#pragma once
+
+#define SAMPLES              101
+
+/* -------------------------------------------------------------------------- */
+
+// time source of the benchmarks:
+// host port:       clock_gettime (nanoseconds)
+// Cortex-M3/M4/M7: DWT->CYCCNT (cycles)
+// other targets:   system timer (ticks)
+
+#if   defined(__unix__)
+
+#include <time.h>
+
+#define BENCH_UNIT           "ns"
+
+static inline
+void BENCH_Init( void )
+{
+}
+
+static inline
+uint32_t BENCH_Now( void )
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)((uint64_t)ts.tv_sec * 1000000000U + (uint64_t)ts.tv_nsec);
+}
+
+#elif defined(DWT_CTRL_CYCCNTENA_Msk)
+
+#define BENCH_UNIT           "cycles"
+
+static inline
+void BENCH_Init( void )
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+static inline
+uint32_t BENCH_Now( void )
+{
+	return DWT->CYCCNT;
+}
+
+#else
+
+#define BENCH_UNIT           "ticks"
+
+static inline
+void BENCH_Init( void )
+{
+}
+
+static inline
+uint32_t BENCH_Now( void )
+{
+	return (uint32_t) sys_time();
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+// every benchmark procedure measures and returns duration of one operation
+typedef uint32_t bench_t( unsigned size );
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+void bench_run( const char *name, bench_t *bench, unsigned size );
+
+#ifdef  __cplusplus
+}
+#endif
+
+#define BENCH_Run(fun, size)   do { uint32_t fun(unsigned); bench_run(#fun, fun, size); } while (0)
@@ -0,0 +1,27 @@
+#include "bench.h"
+
+static mem_t mem = MEM_INIT(1, 16);
+
+uint32_t bench_mem_take_give( unsigned size )
+{
+	static bool bound = false;
+	void *data;
+	uint32_t t;
+	if (!bound)
+	{
+		mem_bind(&mem);
+		bound = true;
+	}
+	t = BENCH_Now();
+	mem_take(&mem, &data);
+	mem_give(&mem, data);
+	(void) size;
+	return BENCH_Now() - t;
+}
+
+uint32_t bench_sys_alloc_free( unsigned size )
+{
+	uint32_t t = BENCH_Now();
+	sys_free(sys_alloc(size));
+	return BENCH_Now() - t;
+}
@@ -0,0 +1,38 @@
+#include "bench.h"
+
+static mtx_t mtx = MTX_INIT(mtxDefault);
+static mtx_t own = MTX_INIT(mtxDefault);
+static sem_t sig = SEM_INIT(0);
+
+static void helper()
+{
+	sem_wait(&sig);
+	mtx_lock(&own);
+	mtx_unlock(&own);
+}
+
+static tsk_t tsk = TSK_INIT(1, helper);
+
+// uncontended lock and unlock
+uint32_t bench_mtx_lock_unlock( unsigned size )
+{
+	uint32_t t = BENCH_Now();
+	mtx_lock(&mtx);
+	mtx_unlock(&mtx);
+	(void) size;
+	return BENCH_Now() - t;
+}
+
+// unlock with the task of higher priority waiting: ownership transfer, context switch there and back
+uint32_t bench_mtx_unlock_contended( unsigned size )
+{
+	uint32_t t;
+	if (tsk.hdr.id == ID_STOPPED)
+		tsk_start(&tsk);
+	mtx_lock(&own);
+	sem_give(&sig);
+	t = BENCH_Now();
+	mtx_unlock(&own);
+	(void) size;
+	return BENCH_Now() - t;
+}
@@ -0,0 +1,45 @@
+#include "bench.h"
+
+static char data[64];
+
+static box_t box4  = BOX_INIT(1,  4);
+static box_t box16 = BOX_INIT(1, 16);
+static box_t box64 = BOX_INIT(1, 64);
+static evq_t evq = EVQ_INIT(1);
+static msg_t msg = MSG_INIT(1, 64);
+static stm_t stm = STM_INIT(64);
+
+// send and receive without context switch
+uint32_t bench_box_give_take( unsigned size )
+{
+	box_t *box = size <= 4 ? &box4 : size <= 16 ? &box16 : &box64;
+	uint32_t t = BENCH_Now();
+	box_give(box, data);
+	box_take(box, data);
+	return BENCH_Now() - t;
+}
+
+uint32_t bench_evq_give_take( unsigned size )
+{
+	unsigned event;
+	uint32_t t = BENCH_Now();
+	evq_give(&evq, size);
+	evq_take(&evq, &event);
+	return BENCH_Now() - t;
+}
+
+uint32_t bench_msg_give_take( unsigned size )
+{
+	uint32_t t = BENCH_Now();
+	msg_give(&msg, data, size);
+	msg_take(&msg, data, size);
+	return BENCH_Now() - t;
+}
+
+uint32_t bench_stm_give_take( unsigned size )
+{
+	uint32_t t = BENCH_Now();
+	stm_give(&stm, data, size);
+	stm_take(&stm, data, size);
+	return BENCH_Now() - t;
+}
@@ -0,0 +1,33 @@
+#include "bench.h"
+
+static sem_t sem = SEM_INIT(0);
+static sem_t sig = SEM_INIT(0);
+
+static void helper()
+{
+	sem_wait(&sig);
+}
+
+static tsk_t tsk = TSK_INIT(1, helper);
+
+// give and take without context switch
+uint32_t bench_sem_give_take( unsigned size )
+{
+	uint32_t t = BENCH_Now();
+	sem_give(&sem);
+	sem_take(&sem);
+	(void) size;
+	return BENCH_Now() - t;
+}
+
+// give to the waiting task of higher priority: context switch there and back
+uint32_t bench_sem_give_switch( unsigned size )
+{
+	uint32_t t;
+	if (tsk.hdr.id == ID_STOPPED)
+		tsk_start(&tsk);
+	t = BENCH_Now();
+	sem_give(&sig);
+	(void) size;
+	return BENCH_Now() - t;
+}
@@ -0,0 +1,21 @@
+#include "bench.h"
+
+static void helper()
+{
+	tsk_yield();
+}
+
+static tsk_t tsk = TSK_INIT(OS_MAIN_PRIO, helper);
+
+// yield to the task of the same priority and back
+uint32_t bench_tsk_yield( unsigned size )
+{
+	uint32_t t;
+	tsk_start(&tsk);
+	t = BENCH_Now();
+	tsk_yield();
+	t = BENCH_Now() - t;
+	tsk_kill(&tsk);
+	(void) size;
+	return t;
+}
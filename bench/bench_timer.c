@@ -0,0 +1,13 @@
+#include "bench.h"
+
+static tmr_t tmr = TMR_INIT(NULL);
+
+// start and stop (reset) of the one-shot timer
+uint32_t bench_tmr_start_stop( unsigned size )
+{
+	uint32_t t = BENCH_Now();
+	tmr_startFor(&tmr, INFINITE - 1);
+	tmr_reset(&tmr);
+	(void) size;
+	return BENCH_Now() - t;
+}
@@ -0,0 +1,86 @@
+/******************************************************************************
+ * @file    stm32f4_discovery.h
+ * @author  Rajmund Szymanski
+ * @date    16.10.2026
+ * @brief   This file contains definitions of virtual STM32F4-Discovery Kit
+ *          for POSIX host.
+ ******************************************************************************/
+
+#ifndef __STM32F4_DISCOVERY_H
+#define __STM32F4_DISCOVERY_H
+
+#include <stdbool.h>
+
+#ifdef  __cplusplus
+extern "C" {
+#endif//__cplusplus
+
+/* -------------------------------------------------------------------------- */
+
+// virtual leds register
+
+static inline
+volatile unsigned *LED_Port( void )
+{
+	static volatile unsigned leds = 0;
+	return &leds;
+}
+
+#define     LEDs (*LED_Port())
+
+/* -------------------------------------------------------------------------- */
+
+// init leds
+
+static inline
+void LED_Init( void )
+{
+	LEDs = 0;
+}
+
+/* -------------------------------------------------------------------------- */
+
+// get user led state
+
+static inline
+bool LED_Get( unsigned nr )
+{
+	return nr < 4 && (LEDs & (1U << nr)) != 0;
+}
+
+/* -------------------------------------------------------------------------- */
+
+// rotate leds
+
+static inline
+void LED_Tick( void )
+{
+	unsigned leds = (LEDs << 1) & 0xE;
+	LEDs = leds ? leds : 0x1;
+}
+
+/* -------------------------------------------------------------------------- */
+
+#ifdef  __cplusplus
+}
+#endif//__cplusplus
+
+/* -------------------------------------------------------------------------- */
+
+#ifdef  __cplusplus
+
+struct Led
+{
+	Led( void ) { LED_Init(); }
+
+	bool get   ( unsigned nr ) { return LED_Get(nr); }
+	void tick  ( void )        {        LED_Tick();  }
+
+	unsigned   operator = ( const unsigned status ) { LEDs = status; return status; }
+};
+
+#endif//__cplusplus
+
+/* -------------------------------------------------------------------------- */
+
+#endif//__STM32F4_DISCOVERY_H
@@ -31,6 +31,9 @@
 
 #pragma once
 
+// kernel features (OS_PRIO_LEVELS ... OS_RING_POW2) can be overridden from the command line,
+// e.g. make -f makefile.host CONFIG=OS_TIMER_WHEEL=16 (see the 'matrix' target of makefile.host)
+
 // ----------------------------
 // cpu frequency in Hz
 // default value: 168000000
@@ -60,12 +63,202 @@
 // default value: 0 (the same as priority of idle process)
 #define OS_MAIN_PRIO          0
 
+// ----------------------------
+// number of task priority levels
+// OS_PRIO_LEVELS == 0 => tasks' queue is a sorted list, any priority value is allowed
+// OS_PRIO_LEVELS >  0 => tasks' queue is indexed by the bitmap of priority levels, scheduler works in constant time, task priorities are limited to OS_PRIO_LEVELS - 1 (max 1024 levels)
+// default value: 0
+#ifndef OS_PRIO_LEVELS
+#define OS_PRIO_LEVELS        0
+#endif
+
+// ----------------------------
+// number of slots at each level of the timers' wheel
+// OS_TIMER_WHEEL == 0 => timers' queue is a sorted list
+// OS_TIMER_WHEEL >  0 => timers' queue is a hierarchical wheel of OS_TIMER_WHEEL slots per level, timers are started and stopped in constant time
+// available values: 0, 2, 4, 8, 16, 32
+// default value: 0
+#ifndef OS_TIMER_WHEEL
+#define OS_TIMER_WHEEL        0
+#endif
+
+// ----------------------------
+// priority of the timer daemon
+// OS_TIMER_DAEMON == 0 => timer callbacks are always executed in the timer interrupt
+// OS_TIMER_DAEMON >  0 => callbacks of timers in tmrDaemon mode are executed by the timer daemon task of priority OS_TIMER_DAEMON (stack size: OS_STACK_SIZE)
+// default value: 0
+#ifndef OS_TIMER_DAEMON
+#define OS_TIMER_DAEMON       0
+#endif
+
+// ----------------------------
+// buckets of the BLOCKED queues
+// OS_QUEUE_BUCKETS == 0 => BLOCKED queues are sorted lists
+// OS_QUEUE_BUCKETS >  0 => objects initialized with '_XXX_INIT_BKT' can have FIFO or bucketed BLOCKED queues, every object header is extended with the pointer to the buckets
+// buckets can be assigned only statically, objects initialized or created at run time have BLOCKED queues sorted by priority
+// default value: 0
+#ifndef OS_QUEUE_BUCKETS
+#define OS_QUEUE_BUCKETS      0
+#endif
+
 // ----------------------------
 // os heap size in bytes
 // OS_HEAP_SIZE == 0 => functions 'xxx_create' use 'malloc' provided with the compiler libraries
 // OS_HEAP_SIZE >  0 => functions 'xxx_create' allocate memory on a dedicated system heap, OS_HEAP_SIZE indicates size of the heap
 // default value: 0
+#ifndef OS_HEAP_SIZE
 #define OS_HEAP_SIZE      16384
+#endif
+
+// ----------------------------
+// os heap allocator
+// OS_HEAP_TLSF == 0 => system heap is a first-fit list of memory segments
+// OS_HEAP_TLSF >  0 => system heap is managed by the two-level segregated fit allocator, memory segments are allocated and released in constant time
+// used only when OS_HEAP_SIZE > 0
+// default value: 0
+#ifndef OS_HEAP_TLSF
+#define OS_HEAP_TLSF          0
+#endif
+
+// ----------------------------
+// os heap walker
+// OS_HEAP_WALK == 0 => heap fragmentation is computed only by the explicit call of 'sys_heapWalk'
+// OS_HEAP_WALK >  0 => the idle task walks through the heap and keeps the heap fragmentation statistics up to date
+// default value: 0
+#ifndef OS_HEAP_WALK
+#define OS_HEAP_WALK          0
+#endif
+
+// ----------------------------
+// number of additional memory regions of the system heap (e.g. CCM, SRAM2, external RAM)
+// OS_HEAP_REGIONS == 0 => system heap consists of one memory region
+// OS_HEAP_REGIONS >  0 => memory regions 1 .. OS_HEAP_REGIONS can be added with 'sys_regionAdd' and used with 'sys_allocIn'
+// default value: 0
+#ifndef OS_HEAP_REGIONS
+#define OS_HEAP_REGIONS       0
+#endif
+
+// ----------------------------
+// memory region for tasks created with 'wrk_create' / 'tsk_create' functions (control block and stack)
+// memory region for objects with data buffers created with 'box_create', 'evq_create', 'job_create', 'mem_create', 'msg_create', 'stm_create' functions
+// region 0 is the system heap, the system heap is used when the region is not available or exhausted
+// default values: 1 (OS_REGION_TSK), 0 (OS_REGION_BUF)
+#ifndef OS_REGION_TSK
+#define OS_REGION_TSK         1
+#endif
+#ifndef OS_REGION_BUF
+#define OS_REGION_BUF         0
+#endif
+
+// ----------------------------
+// number of objects in the slab caches of kernel objects created with 'xxx_create' functions
+// OS_SLAB_XXX == 0 => objects of type xxx_t are allocated on the system heap
+// OS_SLAB_XXX >  0 => objects of type xxx_t are taken from the static slab of OS_SLAB_XXX objects in constant time, the system heap is used when the slab is exhausted
+// available for: BAR, CND, EVT, FLG, LST, MTX, MUT, SEM, SIG, TMR, TSK (only tasks with default stack size OS_STACK_SIZE)
+// default value: 0
+#ifndef OS_SLAB_SEM
+#define OS_SLAB_SEM           0
+#endif
+#ifndef OS_SLAB_MTX
+#define OS_SLAB_MTX           0
+#endif
+#ifndef OS_SLAB_TMR
+#define OS_SLAB_TMR           0
+#endif
+#ifndef OS_SLAB_TSK
+#define OS_SLAB_TSK           0
+#endif
+
+// ----------------------------
+// run time statistics of tasks (run time, switches, preemptions, longest run) and system counters (context switches, wakeups, timer expirations)
+// OS_TASK_STATS == 0 => statistics are not collected
+// OS_TASK_STATS >  0 => statistics are available with 'tsk_stats' and 'sys_stats' functions
+// run time is measured with the cycle counter of frequency CYC_FREQUENCY (DWT->CYCCNT on Cortex-M3 and higher)
+// default value: 0
+#ifndef OS_TASK_STATS
+#define OS_TASK_STATS         0
+#endif
+
+// ----------------------------
+// size of the table of objects with statistics
+// OS_OBJECT_STATS == 0 => object statistics are not collected
+// OS_OBJECT_STATS >  0 => take / give requests, blocking waits, timeouts, wait times, number of waiters and filling level are counted for every object
+// statistics are available with 'xxx_stats' functions and cleared when the object is reset
+// objects are recorded in the table at the first take / give request and listed with 'sys_objectNext' function, objects not recorded because the table is full are counted by 'sys_objectLost' function
+// default value: 0
+#ifndef OS_OBJECT_STATS
+#define OS_OBJECT_STATS       0
+#endif
+
+// ----------------------------
+// size of the kernel trace buffer (in records), must be a power of 2
+// OS_TRACE_SIZE == 0 => kernel trace is disabled
+// OS_TRACE_SIZE >  0 => context switches, wakeups, waits, priority changes, timer events and take / give requests are recorded in the trace buffer
+// the oldest records are overwritten, records are read with 'trc_read' or 'trc_drain' functions
+// default value: 0
+#ifndef OS_TRACE_SIZE
+#define OS_TRACE_SIZE         0
+#endif
+
+// ----------------------------
+// number of call sites recorded by the critical section profiler
+// OS_LOCK_PROFILE == 0 => critical section profiler is disabled
+// OS_LOCK_PROFILE >  0 => duration of every interrupt-masked region is measured with the cycle counter and recorded for the call site that entered the region
+// the longest duration and the histogram of durations are available with 'cri_stats' function
+// default value: 0
+#ifndef OS_LOCK_PROFILE
+#define OS_LOCK_PROFILE       0
+#endif
+
+// ----------------------------
+// number of stack words scanned by the idle task in one critical section
+// OS_STACK_SCAN == 0 => task stacks are painted only in DEBUG mode, stack usage is not tracked
+// OS_STACK_SCAN >  0 => task stacks are always painted, the idle task incrementally scans the stacks of running tasks and keeps their high-water marks
+// high-water marks are available with 'tsk_stackUsed' function
+// default value: 0
+#ifndef OS_STACK_SCAN
+#define OS_STACK_SCAN         0
+#endif
+
+// ----------------------------
+// run-to-completion tasks dispatched on the shared stack
+// OS_STACK_SHARED == 0 => every task uses its private stack
+// OS_STACK_SHARED >  0 => tasks initiated with 'tsk_initShared' function share one stack per priority level (stack resource policy)
+// blocking function called by such a task ends the run of the task, the task state is executed again from the beginning when the wait is over
+// default value: 0
+#ifndef OS_STACK_SHARED
+#define OS_STACK_SHARED       0
+#endif
+
+// ----------------------------
+// proxy tasks
+// OS_TASK_PROXY == 0 => blocking wait is always made by the current task
+// OS_TASK_PROXY >  0 => blocking wait of the current task can be delegated to the proxy task with 'tsk_proxy' function,
+// the wakeup handler of the proxy task is called instead of resuming the task (used by the C++20 coroutine scheduler 'CoScheduler')
+// default value: 0
+#ifndef OS_TASK_PROXY
+#define OS_TASK_PROXY         0
+#endif
+
+// ----------------------------
+// storage of c++ function objects (FUN_t, ACT_t) used by tasks, timers, signal actions and job queues
+// OS_INPLACE_FUNCTION == 0 => std::function (if supported by the port)
+// OS_INPLACE_FUNCTION >  0 => allocation-free InplaceFunction with the inline storage of OS_INPLACE_FUNCTION pointers,
+// only trivially copyable callable objects are accepted, too large callable object generates compilation error
+// default value: 0
+#ifndef OS_INPLACE_FUNCTION
+#define OS_INPLACE_FUNCTION   0
+#endif
+
+// ----------------------------
+// wrapping of positions in ring buffers (stream buffers, message buffers, mailbox queues, event queues, job queues)
+// OS_RING_POW2 == 0 => positions are wrapped with comparison
+// OS_RING_POW2 >  0 => positions in ring buffers of a power-of-two size (in bytes for stream / message buffers and mailbox queues,
+// in items for event / job queues) are wrapped with the mask, ring buffers of other sizes still use comparison
+// default value: 0
+#ifndef OS_RING_POW2
+#define OS_RING_POW2          0
+#endif
 
 // ----------------------------
 // default task stack size in bytes
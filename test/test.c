@@ -1,7 +1,7 @@
 #include "test.h"
 
 #define       LOOP 1
-#define       SIZE 66
+#define       SIZE 90
 
 static cnt_t  summary = 0;
 static fun_t *test[SIZE];
@@ -25,6 +25,8 @@ void test_call(fun_t *fun)
 #endif
 }
 
+#if !defined(BENCH)
+
 static void test_init()
 {
 	TEST_Notify();
@@ -78,5 +80,11 @@ int main()
 
 	test_fini();
 
+#if defined(__unix__)
+	exit(EXIT_SUCCESS);
+#endif
+
 	tsk_stop();
 }
+
+#endif//BENCH
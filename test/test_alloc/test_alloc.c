@@ -6,6 +6,10 @@ void test_alloc()
 	TEST_Add(test_alloc_0);
 	TEST_Add(test_alloc_1);
 	TEST_Add(test_alloc_2);
+	TEST_Add(test_alloc_4);
+	TEST_Add(test_alloc_5);
+	TEST_Add(test_alloc_6);
+	TEST_Add(test_alloc_7);
 #ifndef __CSMC__
 	TEST_Add(test_alloc_3);
 #endif
@@ -0,0 +1,70 @@
+#include "test.h"
+
+#define SIZE 256
+#define LOOP 8
+
+static void check( char *buf, size_t len, char val )
+{
+	size_t i;
+	for (i = 0; i < len; i++)
+		ASSERT(buf[i] == val);
+}
+
+static void proc()
+{
+	char   * buf[LOOP];
+	size_t   len[LOOP];
+	unsigned i;
+
+	for (i = 0; i < LOOP; i++)
+	{
+		len[i] = rand() % (SIZE) + 1;
+		buf[i] = sys_alloc(len[i]);          ASSERT(buf[i]);
+		check(buf[i], len[i], 0);
+		memset(buf[i], (int)i + 1, len[i]);
+	}
+	for (i = 0; i < LOOP; i += 2)
+	{
+		sys_free(buf[i]);
+	}
+	for (i = 1; i < LOOP; i += 2)
+	{
+		buf[i] = sys_realloc(buf[i], len[i] * 2); ASSERT(buf[i]);
+		check(buf[i], len[i], (char)(i + 1));
+		buf[i] = sys_realloc(buf[i], len[i] / 2 + 1); ASSERT(buf[i]);
+		check(buf[i], len[i] / 2 + 1, (char)(i + 1));
+		sys_free(buf[i]);
+	}
+#if OS_HEAP_SIZE && OS_HEAP_TLSF
+	for (i = 0; i < LOOP; i++)
+	{
+		len[i] = rand() % (SIZE) + 1;
+		buf[i] = sys_alignedAlloc(1U << (i + 2), len[i]); ASSERT(buf[i]);
+		ASSERT(((uintptr_t)buf[i] & ((1U << (i + 2)) - 1)) == 0);
+		check(buf[i], len[i], 0);
+		memset(buf[i], 0xFF, len[i]);
+	}
+	for (i = 0; i < LOOP; i++)
+	{
+		sys_free(buf[i]);
+	}
+#endif
+	buf[0] = sys_alloc(SIZE * LOOP * 2);         ASSERT(buf[0]);
+	sys_free(buf[0]);
+	tsk_stop();
+}
+
+static void test()
+{
+	tsk_t  * tsk;
+	unsigned event;
+
+	tsk = tsk_new(1, proc);                      ASSERT(tsk);
+	event = tsk_join(tsk);                       ASSERT_success(event);
+}
+
+void test_alloc_4()
+{
+	TEST_Notify();
+	TEST_Call();
+}
@@ -0,0 +1,38 @@
+#include "test.h"
+
+#define SIZE 256
+
+static void test()
+{
+	hsi_t    info1;
+	hsi_t    info2;
+	void   * buf1;
+	void   * buf2;
+	unsigned event;
+
+	        sys_heapInfo(&info1);
+	buf1  = sys_alloc(SIZE);                     ASSERT(buf1);
+	buf2  = sys_alloc(SIZE);                     ASSERT(buf2);
+	        sys_heapInfo(&info2);
+	                                             ASSERT(info2.allocs == info1.allocs + 2);
+	                                             ASSERT(info2.size == 0 || info2.used >= info1.used + 2 * SIZE);
+	                                             ASSERT(info2.max_used >= info2.used);
+	                                             ASSERT(info2.free == info2.size - info2.used);
+	        sys_free(buf1);
+	event = sys_heapWalk();                      ASSERT(event == (info2.size ? E_SUCCESS : E_FAILURE));
+	        sys_heapInfo(&info1);
+	                                             ASSERT(info1.frees == info2.frees + 1);
+	                                             ASSERT(info1.largest <= info1.free);
+	                                             ASSERT(info1.size == 0 || info1.blocks > 0);
+	                                             ASSERT(info1.frag <= 100);
+	        sys_free(buf2);
+	        sys_heapInfo(&info2);
+	                                             ASSERT(info2.frees == info1.frees + 1);
+	                                             ASSERT(info2.max_used >= info1.max_used);
+}
+
+void test_alloc_5()
+{
+	TEST_Notify();
+	TEST_Call();
+}
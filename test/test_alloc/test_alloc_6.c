@@ -0,0 +1,43 @@
+#include "test.h"
+
+#define SIZE 8
+
+static void proc()
+{
+	        tsk_stop();
+}
+
+static void test()
+{
+	sem_t  * sem[SIZE];
+	tsk_t  * tsk[SIZE];
+	sem_t  * tmp;
+	unsigned event;
+	unsigned i;
+
+	for (i = 0; i < SIZE; i++)
+	{
+		sem[i] = sem_create(i, semCounting);     ASSERT(sem[i]);
+		                                         ASSERT(sem_getValue(sem[i]) == i);
+		tsk[i] = tsk_create(1, proc);            ASSERT(tsk[i]);
+	}
+	for (i = 0; i < SIZE; i++)
+	{
+		                                         ASSERT(sem[i]->obj.res == sem[i]);
+		        sem_delete(sem[i]);
+		                                         ASSERT(tsk[i]->hdr.obj.res == tsk[i]);
+		event = tsk_join(tsk[i]);                ASSERT_success(event);
+	}
+	tmp   = sem_create(0, semBinary);            ASSERT(tmp);
+	                                             ASSERT(sem_getValue(tmp) == 0);
+#if OS_SLAB_SEM
+	                                             ASSERT(OS_SLAB_SEM < SIZE || tmp == sem[SIZE - 1]);
+#endif
+	        sem_delete(tmp);
+}
+
+void test_alloc_6()
+{
+	TEST_Notify();
+	TEST_Call();
+}
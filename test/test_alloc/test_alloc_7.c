@@ -0,0 +1,56 @@
+#include "test.h"
+
+#define SIZE 256
+
+static stk_t region[512];
+static bool  added = false;
+
+#define IN_REGION(ptr) ((char *)(ptr) >= (char *)region && (char *)(ptr) < (char *)region + sizeof(region))
+
+static void proc()
+{
+	        tsk_stop();
+}
+
+static void test()
+{
+	char   * buf1;
+	char   * buf2;
+	tsk_t  * tsk;
+	unsigned event;
+	unsigned i;
+
+	event = sys_regionAdd(1, region, sizeof(region));
+#if OS_HEAP_REGIONS
+	                                             ASSERT(added || event == E_SUCCESS);
+	                                             ASSERT(!added || event == E_FAILURE);
+	added = true;
+#else
+	                                             ASSERT_failure(event);
+	(void) added;
+#endif
+	buf1  = sys_allocIn(1, SIZE);                ASSERT(buf1);
+	                                             ASSERT(IN_REGION(buf1) == (OS_HEAP_REGIONS > 0));
+	buf2  = sys_allocIn(0, SIZE);                ASSERT(buf2);
+	                                             ASSERT(!IN_REGION(buf2));
+	for (i = 0; i < SIZE; i++)
+		                                         ASSERT(buf1[i] == 0 && buf2[i] == 0);
+	        memset(buf1, 0x55, SIZE);
+	buf1  = sys_realloc(buf1, SIZE * 2);         ASSERT(buf1);
+	for (i = 0; i < SIZE; i++)
+		                                         ASSERT(buf1[i] == 0x55);
+	        sys_free(buf1);
+	        sys_free(buf2);
+	tsk   = wrk_create(1, proc, SIZE);           ASSERT(tsk);
+	                                             ASSERT(IN_REGION(tsk) == (OS_HEAP_REGIONS > 0 && OS_REGION_TSK == 1));
+	event = tsk_join(tsk);                       ASSERT_success(event);
+	buf1  = sys_allocIn(1, sizeof(region));      ASSERT(buf1);
+	                                             ASSERT(!IN_REGION(buf1));
+	        sys_free(buf1);
+}
+
+void test_alloc_7()
+{
+	TEST_Notify();
+	TEST_Call();
+}
@@ -7,5 +7,6 @@ void test_job_queue()
 #ifndef __CSMC__
 	TEST_Add(test_job_queue_2);
 	TEST_Add(test_job_queue_3);
+	TEST_Add(test_job_queue_4);
 #endif
 }
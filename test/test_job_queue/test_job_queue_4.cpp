@@ -0,0 +1,49 @@
+#include "test.h"
+
+#if OS_INPLACE_FUNCTION
+
+static_assert(std::is_trivially_copyable<FUN_t>::value, "unexpected error!");
+
+static auto Job = JobQueueT<2>();
+
+static unsigned value;
+
+static void test()
+{
+	unsigned event;
+	unsigned step = 1;
+	FUN_t    fun;
+	                                             ASSERT(!fun);
+	value = 0;
+	event = Job.give([step]{ value += step; });  ASSERT_success(event);
+	step = 2;
+	event = Job.give([&step]{ value += step; }); ASSERT_success(event);
+	step = 4;
+	event = Job.take();                          ASSERT_success(event);
+	                                             ASSERT(value == 1);
+	event = Job.take();                          ASSERT_success(event);
+	                                             ASSERT(value == 5);
+	event = Job.take();                          ASSERT_timeout(event);
+	fun = [&step]{ value = step; };              ASSERT(!!fun);
+	step = 8;
+	        fun();                               ASSERT(value == 8);
+	                                             ASSERT(!Tsk1);
+	        Tsk1.startFrom([step]{ value += step; ThisTask::stop(); });
+	event = Tsk1.join();                         ASSERT_success(event);
+	                                             ASSERT(value == 16);
+}
+
+#else
+
+static void test()
+{
+}
+
+#endif
+
+extern "C"
+void test_job_queue_4()
+{
+	TEST_Notify();
+	TEST_Call();
+}
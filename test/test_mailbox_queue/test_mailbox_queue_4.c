@@ -0,0 +1,41 @@
+#include "test.h"
+#include <string.h>
+
+static_BOX(box4, 5, 3); // ring buffer of 15 bytes, positions are wrapped with comparison
+static_BOX(box5, 4, 4); // ring buffer of 16 bytes, positions are wrapped with the mask if OS_RING_POW2 > 0
+
+static void check( box_t *box )
+{
+	char     data[4];
+	unsigned event;
+	unsigned i;
+
+	for (i = 0; i < 16; i++)
+	{
+		memset(data, 'a' + (int)i, sizeof(data));
+		event = box_give(box, data);             ASSERT_success(event);
+		event = box_give(box, data);             ASSERT_success(event);
+		event = box_give(box, data);             ASSERT_success(event);
+		memset(data, 0, sizeof(data));
+		event = box_take(box, data);             ASSERT_success(event);
+		ASSERT(data[0] == 'a' + (int)i && data[box->size - 1] == 'a' + (int)i);
+		event = box_take(box, data);             ASSERT_success(event);
+		event = box_take(box, data);             ASSERT_success(event);
+		ASSERT(box_count(box) == 0);
+	}
+}
+
+static void test()
+{
+#if OS_RING_POW2
+	                                             ASSERT(box4->mask == 0 && box5->mask == 15);
+#endif
+	        check(box4);
+	        check(box5);
+}
+
+void test_mailbox_queue_4()
+{
+	TEST_Notify();
+	TEST_Call();
+}
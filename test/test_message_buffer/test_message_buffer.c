@@ -4,6 +4,7 @@ void test_message_buffer()
 {
 	UNIT_Notify();
 	TEST_Add(test_message_buffer_1);
+	TEST_Add(test_message_buffer_4);
 #ifndef __CSMC__
 	TEST_Add(test_message_buffer_2);
 	TEST_Add(test_message_buffer_3);
@@ -0,0 +1,59 @@
+#include "test.h"
+
+static_MSG(msg4, 13);
+
+static const char sent[] = "span";
+
+static void range_put( rng_t *rng, const char *data, unsigned size )
+{
+	memcpy(rng->data[0], data, rng->size[0]);
+	memcpy(rng->data[1], data + rng->size[0], size - rng->size[0]);
+}
+
+static bool range_cmp( rng_t *rng, const char *data, unsigned size )
+{
+	return rng->size[0] + rng->size[1] == size &&
+	       memcmp(rng->data[0], data, rng->size[0]) == 0 &&
+	       memcmp(rng->data[1], data + rng->size[0], rng->size[1]) == 0;
+}
+
+static void proc()
+{
+	unsigned bytes;
+	char     data[sizeof(sent)];
+
+	bytes = msg_wait(msg4, data, sizeof(data));  ASSERT(bytes == sizeof(sent));
+	                                             ASSERT(memcmp(data, sent, sizeof(sent)) == 0);
+	        tsk_stop();
+}
+
+static void test()
+{
+	unsigned event;
+	unsigned bytes;
+	rng_t    rng;
+	                                             ASSERT(msg_count(msg4) == 0);
+	event = msg_reserve(msg4, &rng, sizeof(sent)); ASSERT_success(event);
+	        range_put(&rng, sent, sizeof(sent));
+	        msg_commit(msg4, sizeof(sent));      ASSERT(msg_count(msg4) == sizeof(unsigned) + sizeof(sent));
+	event = msg_reserve(msg4, &rng, sizeof(sent)); ASSERT_timeout(event);
+	event = msg_reserve(msg4, &rng, 10);         ASSERT_failure(event);
+	bytes = msg_peekSpan(msg4, &rng);            ASSERT(bytes == sizeof(sent));
+	                                             ASSERT(range_cmp(&rng, sent, sizeof(sent)));
+	        msg_release(msg4);                   ASSERT(msg_count(msg4) == 0);
+	bytes = msg_peekSpan(msg4, &rng);            ASSERT_timeout(bytes);
+	                                             ASSERT_dead(tsk1);
+	        tsk_startFrom(tsk1, proc);           ASSERT_ready(tsk1);
+	        tsk_yield();
+	        tsk_yield();
+	event = msg_reserve(msg4, &rng, sizeof(sent)); ASSERT_success(event);
+	        range_put(&rng, sent, sizeof(sent));
+	        msg_commit(msg4, sizeof(sent));      ASSERT(msg_count(msg4) == 0);
+	event = tsk_join(tsk1);                      ASSERT_success(event);
+}
+
+void test_message_buffer_4()
+{
+	TEST_Notify();
+	TEST_Call();
+}
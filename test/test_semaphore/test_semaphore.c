@@ -4,6 +4,8 @@ void test_semaphore()
 {
 	UNIT_Notify();
 	TEST_Add(test_semaphore_1);
+	TEST_Add(test_semaphore_4);
+	TEST_Add(test_semaphore_5);
 #ifndef __CSMC__
 	TEST_Add(test_semaphore_2);
 	TEST_Add(test_semaphore_3);
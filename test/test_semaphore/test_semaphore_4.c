@@ -0,0 +1,64 @@
+#include "test.h"
+
+#if OS_QUEUE_BUCKETS
+
+static bkt_t bkt4 = _BKT_INIT(1, _BKT_DATA(1)); // strict FIFO queue
+static bkt_t bkt5 = _BKT_INIT(4, _BKT_DATA(4)); // priority buckets 0, 1, 2, 3 and higher
+
+static sem_t sem4 = _SEM_INIT_BKT(0, semCounting, &bkt4);
+static sem_t sem5 = _SEM_INIT_BKT(0, semCounting, &bkt5);
+
+static sem_t  *sem;
+static unsigned order[3];
+static unsigned counter;
+
+static void proc()
+{
+	unsigned event;
+
+	event = sem_wait(sem);                       ASSERT_success(event);
+	        order[counter++] = tsk_getPrio();
+	        tsk_stop();
+}
+
+static void check( sem_t *s )
+{
+	unsigned event;
+
+	        sem = s;
+	        counter = 0;
+	        tsk_startFrom(tsk1, proc);           ASSERT_ready(tsk1);
+	        tsk_startFrom(tsk4, proc);           ASSERT_ready(tsk4);
+	        tsk_startFrom(tsk3, proc);           ASSERT_ready(tsk3);
+	        tsk_startFrom(tsk2, proc);           ASSERT_ready(tsk2);
+	        tsk_reset(tsk4);                     ASSERT_dead(tsk4);
+	event = sem_give(sem);                       ASSERT_success(event);
+	event = sem_give(sem);                       ASSERT_success(event);
+	event = sem_give(sem);                       ASSERT_success(event);
+	event = tsk_join(tsk1);                      ASSERT_success(event);
+	event = tsk_join(tsk2);                      ASSERT_success(event);
+	event = tsk_join(tsk3);                      ASSERT_success(event);
+	                                             ASSERT(counter == 3);
+}
+
+static void test()
+{
+	        check(&sem4);
+	                                             ASSERT(order[0] == 1 && order[1] == 3 && order[2] == 2);
+	        check(&sem5);
+	                                             ASSERT(order[0] == 3 && order[1] == 2 && order[2] == 1);
+}
+
+#else
+
+static void test()
+{
+}
+
+#endif
+
+void test_semaphore_4()
+{
+	TEST_Notify();
+	TEST_Call();
+}
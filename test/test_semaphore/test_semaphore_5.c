@@ -0,0 +1,67 @@
+#include "test.h"
+
+#if OS_OBJECT_STATS
+
+static_SEM(sem3, 0, semCounting);
+
+static void proc()
+{
+	unsigned event;
+
+	event = sem_waitFor(sem3, 1);                ASSERT_timeout(event);
+	event = sem_wait(sem3);                      ASSERT_success(event);
+	        tsk_stop();
+}
+
+static bool found( const void *obj )
+{
+	const void *nxt = NULL;
+
+	while ((nxt = sys_objectNext(nxt)) != NULL)
+		if (nxt == obj)
+			return true;
+
+	return false;
+}
+
+static void test()
+{
+	ost_t    st0, st1;
+	unsigned event;
+	unsigned lost;
+
+	        sem_reset(sem3);                     // the statistics are cleared and the object is forgotten
+	        sem_stats(sem3, &st0);               ASSERT(st0.takes == 0 && st0.gives == 0);
+	lost  = sys_objectLost();
+	        tsk_startFrom(tsk2, proc);
+	        tsk_sleepFor(2);
+	event = sem_give(sem3);                      ASSERT_success(event);
+	event = tsk_join(tsk2);                      ASSERT_success(event);
+	event = sem_give(sem3);                      ASSERT_success(event);
+	event = sem_take(sem3);                      ASSERT_success(event);
+	        sem_stats(sem3, &st1);               ASSERT(st1.takes    == st0.takes + 3);
+	                                             ASSERT(st1.gives    == st0.gives + 2);
+	                                             ASSERT(st1.waits    == st0.waits + 2);
+	                                             ASSERT(st1.timeouts == st0.timeouts + 1);
+	                                             ASSERT(st1.time     >  st0.time);
+	                                             ASSERT(st1.max      >  0);
+	                                             ASSERT(st1.waiters  == 0);
+	                                             ASSERT(st1.depth    == 1);
+	                                             ASSERT(st1.peak     == 1);
+	                                             ASSERT(found(sem3) || sys_objectLost() > lost);
+	        sys_objectStats(sem3, &st0);         ASSERT(st0.takes == st1.takes);
+}
+
+#else
+
+static void test()
+{
+}
+
+#endif
+
+void test_semaphore_5()
+{
+	TEST_Notify();
+	TEST_Call();
+}
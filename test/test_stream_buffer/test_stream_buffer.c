@@ -4,6 +4,9 @@ void test_stream_buffer()
 {
 	UNIT_Notify();
 	TEST_Add(test_stream_buffer_1);
+	TEST_Add(test_stream_buffer_4);
+	TEST_Add(test_stream_buffer_5);
+	TEST_Add(test_stream_buffer_6);
 #ifndef __CSMC__
 	TEST_Add(test_stream_buffer_2);
 	TEST_Add(test_stream_buffer_3);
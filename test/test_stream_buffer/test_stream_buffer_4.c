@@ -0,0 +1,68 @@
+#include "test.h"
+
+static_STM(stm4, 7);
+
+static const char sent[] = "span";
+
+static void range_put( rng_t *rng, const char *data, unsigned size )
+{
+	memcpy(rng->data[0], data, rng->size[0]);
+	memcpy(rng->data[1], data + rng->size[0], size - rng->size[0]);
+}
+
+static bool range_cmp( rng_t *rng, const char *data, unsigned size )
+{
+	return rng->size[0] + rng->size[1] == size &&
+	       memcmp(rng->data[0], data, rng->size[0]) == 0 &&
+	       memcmp(rng->data[1], data + rng->size[0], rng->size[1]) == 0;
+}
+
+static void proc()
+{
+	unsigned bytes;
+	char     data[sizeof(sent)];
+
+	bytes = stm_wait(stm4, data, sizeof(data));  ASSERT(bytes == sizeof(sent));
+	                                             ASSERT(memcmp(data, sent, sizeof(sent)) == 0);
+	        tsk_stop();
+}
+
+static void test()
+{
+	unsigned event;
+	unsigned bytes;
+	rng_t    rng;
+#if OS_OBJECT_STATS
+	ost_t    st1, st2;
+#endif
+	                                             ASSERT(stm_count(stm4) == 0);
+	event = stm_reserve(stm4, &rng, sizeof(sent)); ASSERT_success(event);
+	        range_put(&rng, sent, sizeof(sent));
+	        stm_commit(stm4, sizeof(sent));      ASSERT(stm_count(stm4) == sizeof(sent));
+#if OS_OBJECT_STATS
+	        stm_stats(stm4, &st1);
+#endif
+	event = stm_reserve(stm4, &rng, sizeof(sent)); ASSERT_timeout(event);
+	event = stm_reserve(stm4, &rng, 10);         ASSERT_failure(event);
+#if OS_OBJECT_STATS
+	        stm_stats(stm4, &st2);               ASSERT(st2.gives == st1.gives);
+#endif
+	bytes = stm_peekSpan(stm4, &rng);            ASSERT(bytes == sizeof(sent));
+	                                             ASSERT(range_cmp(&rng, sent, sizeof(sent)));
+	        stm_release(stm4, bytes);            ASSERT(stm_count(stm4) == 0);
+	bytes = stm_peekSpan(stm4, &rng);            ASSERT_timeout(bytes);
+	                                             ASSERT_dead(tsk1);
+	        tsk_startFrom(tsk1, proc);           ASSERT_ready(tsk1);
+	        tsk_yield();
+	        tsk_yield();
+	event = stm_reserve(stm4, &rng, sizeof(sent)); ASSERT_success(event);
+	        range_put(&rng, sent, sizeof(sent));
+	        stm_commit(stm4, sizeof(sent));      ASSERT(stm_count(stm4) == 0);
+	event = tsk_join(tsk1);                      ASSERT_success(event);
+}
+
+void test_stream_buffer_4()
+{
+	TEST_Notify();
+	TEST_Call();
+}
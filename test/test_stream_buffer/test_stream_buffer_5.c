@@ -0,0 +1,72 @@
+#include "test.h"
+
+#define LIMIT 7
+
+static_STM(stm5, LIMIT);
+
+static const char sent[] = "trig";
+
+static void proc()
+{
+	unsigned bytes;
+	char     data[LIMIT];
+
+	bytes = stm_waitMin(stm5, data, sizeof(sent), sizeof(data)); ASSERT(bytes == sizeof(sent));
+	                                             ASSERT(memcmp(data, sent, sizeof(sent)) == 0);
+	bytes = stm_waitMin(stm5, data, LIMIT, sizeof(data)); ASSERT(bytes == sizeof(sent));
+	                                             ASSERT(memcmp(data, sent, sizeof(sent)) == 0);
+	        tsk_stop();
+}
+
+static void writer()
+{
+	unsigned event;
+
+	event = stm_send(stm5, "writer", 6);         ASSERT_success(event);
+	        tsk_stop();
+}
+
+static void test()
+{
+	unsigned event;
+	unsigned bytes;
+	char     data[LIMIT];
+	                                             ASSERT(stm_count(stm5) == 0);
+	event = stm_give(stm5, sent, 2);             ASSERT_success(event);
+	bytes = stm_waitMinFor(stm5, data, sizeof(sent), sizeof(data), IMMEDIATE); ASSERT_timeout(bytes);
+	                                             ASSERT(stm_count(stm5) == 2);
+	bytes = stm_take(stm5, data, sizeof(data));  ASSERT(bytes == 2);
+	                                             ASSERT_dead(tsk1);
+	        tsk_startFrom(tsk1, proc);           ASSERT_ready(tsk1);
+	        tsk_yield();
+	        tsk_yield();
+	event = stm_give(stm5, sent, 2);             ASSERT_success(event);
+	                                             ASSERT(stm_count(stm5) == 2);
+	event = stm_give(stm5, sent + 2, sizeof(sent) - 2); ASSERT_success(event);
+	                                             ASSERT(stm_count(stm5) == 0);
+	        tsk_yield();
+	        tsk_yield();
+	event = stm_give(stm5, sent, sizeof(sent));  ASSERT_success(event);
+	                                             ASSERT(stm_count(stm5) == sizeof(sent));
+	event = stm_give(stm5, sent, sizeof(sent));  ASSERT_success(event);
+	                                             ASSERT(stm_count(stm5) == sizeof(sent));
+	bytes = stm_take(stm5, data, sizeof(data));  ASSERT(bytes == sizeof(sent));
+	event = tsk_join(tsk1);                      ASSERT_success(event);
+	event = stm_give(stm5, sent, 3);             ASSERT_success(event);
+	        tsk_startFrom(tsk1, writer);         ASSERT_ready(tsk1);
+	        tsk_yield();
+	        tsk_yield();
+	                                             ASSERT(stm_count(stm5) == 3);
+	bytes = stm_waitMin(stm5, data, 5, sizeof(data)); ASSERT(bytes == 3);
+	                                             ASSERT(memcmp(data, sent, 3) == 0);
+	                                             ASSERT(stm_count(stm5) == 6);
+	bytes = stm_take(stm5, data, sizeof(data));  ASSERT(bytes == 6);
+	                                             ASSERT(memcmp(data, "writer", 6) == 0);
+	event = tsk_join(tsk1);                      ASSERT_success(event);
+}
+
+void test_stream_buffer_5()
+{
+	TEST_Notify();
+	TEST_Call();
+}
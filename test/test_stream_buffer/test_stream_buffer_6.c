@@ -0,0 +1,51 @@
+#include "test.h"
+
+#define LIMIT 7
+
+static_STM(stm6, LIMIT);
+
+static const char sent[] = "streamed-through-the-buffer";
+
+static void proc()
+{
+	unsigned bytes;
+
+	bytes = stm_write(stm6, sent, sizeof(sent)); ASSERT(bytes == sizeof(sent));
+	bytes = stm_write(stm6, sent, sizeof(sent)); ASSERT(bytes == sizeof(sent));
+	        tsk_stop();
+}
+
+static void test()
+{
+	unsigned bytes;
+	unsigned count;
+	char     data[sizeof(sent)];
+	                                             ASSERT(stm_count(stm6) == 0);
+	bytes = stm_writeFor(stm6, sent, sizeof(sent), IMMEDIATE); ASSERT(bytes == LIMIT);
+	bytes = stm_take(stm6, data, sizeof(data));  ASSERT(bytes == LIMIT);
+	                                             ASSERT(memcmp(data, sent, LIMIT) == 0);
+	                                             ASSERT_dead(tsk1);
+	        tsk_startFrom(tsk1, proc);           ASSERT_ready(tsk1);
+	        tsk_yield();
+	        tsk_yield();
+	                                             ASSERT(stm_count(stm6) == LIMIT);
+	for (count = 0; count < sizeof(sent); count += bytes)
+	{
+	bytes = stm_wait(stm6, data + count, sizeof(data) - count); ASSERT(bytes <= LIMIT);
+	}
+	                                             ASSERT(memcmp(data, sent, sizeof(sent)) == 0);
+	        tsk_yield();
+	        tsk_yield();
+	                                             ASSERT(stm_count(stm6) == LIMIT);
+	bytes = stm_push(stm6, "!", 1);              ASSERT_success(bytes);
+	bytes = stm_take(stm6, data, sizeof(data));  ASSERT(bytes == LIMIT);
+	                                             ASSERT(memcmp(data, sent + sizeof(sent) - LIMIT + 1, LIMIT - 1) == 0);
+	                                             ASSERT(data[LIMIT - 1] == '!');
+	bytes = tsk_join(tsk1);                      ASSERT_success(bytes);
+}
+
+void test_stream_buffer_6()
+{
+	TEST_Notify();
+	TEST_Call();
+}
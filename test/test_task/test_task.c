@@ -7,14 +7,27 @@ void test_task()
 	TEST_Add(test_task_create_1);
 	TEST_Add(test_task_create_2);
 	TEST_Add(test_task_create_3);
+#ifndef PORT_SIMULATOR
 	TEST_Add(test_task_infinite_loop_1);
+#endif
 	TEST_Add(test_task_signal_1);
+	TEST_Add(test_task_stats_1);
+	TEST_Add(test_task_trace_1);
+	TEST_Add(test_task_profile_1);
+	TEST_Add(test_task_stack_1);
+	TEST_Add(test_task_shared_1);
+	TEST_Add(test_task_shared_2);
+	TEST_Add(test_task_proxy_1);
+	TEST_Add(test_task_prio_1);
 #ifndef __CSMC__
+#ifndef PORT_SIMULATOR
 	TEST_Add(test_task_infinite_loop_2);
 	TEST_Add(test_task_infinite_loop_3);
+#endif
 	TEST_Add(test_task_signal_2);
 	TEST_Add(test_task_signal_3);
 	TEST_Add(test_task_create_4);
 	TEST_Add(test_task_create_5);
+	TEST_Add(test_task_coroutine_1);
 #endif
 }
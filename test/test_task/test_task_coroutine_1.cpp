@@ -0,0 +1,62 @@
+#include "test.h"
+
+#if defined(__cpp_impl_coroutine) && OS_TASK_PROXY
+
+static CoScheduler sch;
+static unsigned    done;
+
+static CoTask proc_a()
+{
+	unsigned event;
+
+	event = co_await ThisCoroutine::wait(sem1);        ASSERT_success(event);
+	event = co_await ThisCoroutine::waitFor(sem1, 1);  ASSERT_timeout(event);
+	event = sem_give(sem1);                            ASSERT_success(event);
+	event = co_await ThisCoroutine::wait(sem1);        ASSERT_success(event); // without suspension
+	        done++;
+}
+
+static CoTask proc_b()
+{
+	unsigned event;
+
+	event = co_await ThisCoroutine::sleepFor(1);       ASSERT_timeout(event);
+	event = sem_give(sem1);                            ASSERT_success(event);
+	        done++;
+}
+
+static void proc()
+{
+	unsigned event;
+
+	event = sch.spawn(proc_a());                       ASSERT_success(event);
+	event = sch.spawn(proc_b());                       ASSERT_success(event);
+	while (done < 2) sch.run();
+	        tsk_stop();
+}
+
+static void test()
+{
+	unsigned event;
+
+	done = 0;
+	                                                   ASSERT_dead(tsk1);
+	        tsk_startFrom(tsk1, proc);
+	event = tsk_join(tsk1);                            ASSERT_success(event);
+	                                                   ASSERT(done == 2);
+}
+
+#else
+
+static void test()
+{
+}
+
+#endif
+
+extern "C"
+void test_task_coroutine_1()
+{
+	TEST_Notify();
+	TEST_Call();
+}
@@ -0,0 +1,40 @@
+#include "test.h"
+
+#if OS_PRIO_LEVELS
+#define PRIO_MAX (OS_PRIO_LEVELS - 1) // task priorities are limited to the bitmap priority levels
+#else
+#define PRIO_MAX (UINT_MAX)           // any priority value is allowed
+#endif
+
+static unsigned prio;
+
+static void proc()
+{
+	        prio = tsk_getPrio();
+	        tsk_setPrio(UINT_MAX);               ASSERT(tsk_getPrio() == PRIO_MAX);
+	        tsk_stop();
+}
+
+static void test()
+{
+	tsk_t  * tsk;
+	unsigned event;
+
+	tsk_t tsk9 = TSK_INIT(UINT_MAX, proc);
+
+	        prio = 0;
+	        tsk_start(&tsk9);                    ASSERT_dead(&tsk9);
+	                                             ASSERT(prio == PRIO_MAX);
+	event = tsk_join(&tsk9);                     ASSERT_success(event);
+	        prio = 0;
+	tsk   = tsk_create(UINT_MAX, proc);          ASSERT(tsk);
+	                                             ASSERT_dead(tsk);
+	                                             ASSERT(prio == PRIO_MAX);
+	event = tsk_join(tsk);                       ASSERT_success(event);
+}
+
+void test_task_prio_1()
+{
+	TEST_Notify();
+	TEST_Call();
+}
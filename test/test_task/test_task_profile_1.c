@@ -0,0 +1,57 @@
+#include "test.h"
+
+#if OS_LOCK_PROFILE
+
+#define SIZE 8
+
+static cri_t rec[SIZE];
+
+static void proc()
+{
+	        sem_give(sem1);
+	        tsk_stop();
+}
+
+static unsigned total( const cri_t *cri )
+{
+	unsigned sum = 0;
+	unsigned i;
+
+	for (i = 0; i < CRI_BUCKETS; i++)
+		sum += cri->hist[i];
+
+	return sum;
+}
+
+static void test()
+{
+	unsigned event;
+	unsigned cnt;
+	unsigned i;
+
+	        cri_reset();
+	        tsk_startFrom(tsk2, proc);
+	event = tsk_join(tsk2);                      ASSERT_success(event);
+	event = sem_take(sem1);                      ASSERT_success(event);
+	cnt   = cri_stats(rec, SIZE);                ASSERT(cnt > 1 && cnt <= SIZE);
+	for (i = 0; i < cnt; i++)                    ASSERT(rec[i].count > 0 && total(&rec[i]) == rec[i].count);
+	for (i = 1; i < cnt; i++)                    ASSERT(rec[i - 1].max >= rec[i].max);
+#if defined(__GNUC__)
+	for (i = 0; i < cnt; i++)                    ASSERT(rec[i].site != NULL);
+#endif
+	cnt   = cri_stats(rec, 1);                   ASSERT(cnt == 1);
+}
+
+#else
+
+static void test()
+{
+}
+
+#endif
+
+void test_task_profile_1()
+{
+	TEST_Notify();
+	TEST_Call();
+}
@@ -0,0 +1,53 @@
+#include "test.h"
+
+#if OS_TASK_PROXY
+
+static tsk_t    pxy;
+static unsigned cnt;
+
+static void wakeup( tsk_t *tsk )
+{
+	                                             ASSERT(tsk == &pxy);
+	        cnt++;
+}
+
+static void test()
+{
+	unsigned event;
+
+	cnt = 0;
+	        tsk_proxy(&pxy, wakeup);
+	event = sem_wait(sem1);                      ASSERT_timeout(event);
+	                                             ASSERT(pxy.guard != NULL);
+	                                             ASSERT(cnt == 0);
+	event = sem_give(sem1);                      ASSERT_success(event);
+	                                             ASSERT(pxy.guard == NULL);
+	                                             ASSERT(pxy.event == E_SUCCESS);
+	                                             ASSERT(cnt == 1);
+	        tsk_proxy(&pxy, wakeup);
+	        tsk_sleepFor(2);
+	                                             ASSERT(pxy.guard != NULL);
+	event = sem_waitFor(sem1, 3);                ASSERT_timeout(event); // the proxy is used only once
+	                                             ASSERT(cnt == 2);
+	                                             ASSERT(pxy.event == E_TIMEOUT);
+	        tsk_proxy(&pxy, wakeup);
+	event = sem_waitFor(sem1, 1);                ASSERT_timeout(event);
+	event = tsk_reset(&pxy);                     ASSERT_success(event);
+	                                             ASSERT(pxy.guard == NULL);
+	        tsk_sleepFor(2);
+	                                             ASSERT(cnt == 2);
+}
+
+#else
+
+static void test()
+{
+}
+
+#endif
+
+void test_task_proxy_1()
+{
+	TEST_Notify();
+	TEST_Call();
+}
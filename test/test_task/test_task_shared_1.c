@@ -0,0 +1,52 @@
+#include "test.h"
+
+#if OS_STACK_SHARED
+
+static stk_t    stack[STK_SIZE(OS_STACK_SIZE)];
+static tsk_t    shr[2];
+static unsigned runs;
+static unsigned rest;
+
+static void proc()
+{
+	                                             ASSERT(tsk_this()->event == E_SUCCESS);
+	        runs++;
+	        sem_wait(sem1);                      // ends the run
+	        rest++;
+}
+
+static void test()
+{
+	unsigned event;
+
+	runs = rest = 0;
+	        tsk_initShared(&shr[0], 1, proc, stack, sizeof(stack));
+	        tsk_initShared(&shr[1], 1, proc, stack, sizeof(stack));
+	                                             ASSERT(runs == 2);
+	event = sem_give(sem1);                      ASSERT_success(event);
+	event = sem_give(sem1);                      ASSERT_success(event);
+	                                             ASSERT(runs == 4);
+	        tsk_setPrio(2);
+	event = sem_give(sem1);                      ASSERT_success(event);
+	event = sem_give(sem1);                      ASSERT_success(event);
+	                                             ASSERT(runs == 4);
+	        tsk_setPrio(0);
+	                                             ASSERT(runs == 6);
+	                                             ASSERT(rest == 0);
+	event = tsk_reset(&shr[0]);                  ASSERT_success(event);
+	event = tsk_reset(&shr[1]);                  ASSERT_success(event);
+}
+
+#else
+
+static void test()
+{
+}
+
+#endif
+
+void test_task_shared_1()
+{
+	TEST_Notify();
+	TEST_Call();
+}
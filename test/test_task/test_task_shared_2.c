@@ -0,0 +1,64 @@
+#include "test.h"
+
+#if OS_STACK_SHARED
+
+static stk_t    stack[STK_SIZE(OS_STACK_SIZE)];
+static tsk_t    shr;
+static unsigned runs;
+static unsigned rest;
+
+static void proc2()
+{
+	unsigned event;
+
+	event = tsk_suspend(&shr);                   ASSERT_failure(event); // the task holds the frame on the shared stack
+	        tsk_stop();
+}
+
+static void proc()
+{
+	volatile unsigned frame = runs + 1;          // the frame on the shared stack
+
+	        tsk_startFrom(tsk2, proc2);          // preempts the task
+	                                             ASSERT(frame == runs + 1);
+	        runs++;
+	        rest++;
+	        sem_wait(sem1);                      // ends the run
+}
+
+static void test()
+{
+	unsigned event;
+
+	runs = rest = 0;
+	        tsk_initShared(&shr, 1, proc, stack, sizeof(stack));
+	                                             ASSERT_dead(tsk2);
+	                                             ASSERT(runs == 1);
+	                                             ASSERT(rest == 1);
+	event = tsk_join(tsk2);                      ASSERT_success(event);
+	        tsk_setPrio(2);
+	event = sem_give(sem1);                      ASSERT_success(event);
+	event = tsk_suspend(&shr);                   ASSERT_success(event); // the run has not started yet
+	        tsk_setPrio(0);
+	                                             ASSERT(runs == 1);
+	event = tsk_resume(&shr);                    ASSERT_success(event);
+	                                             ASSERT_dead(tsk2);
+	                                             ASSERT(runs == 2);
+	                                             ASSERT(rest == 2);
+	event = tsk_join(tsk2);                      ASSERT_success(event);
+	event = tsk_reset(&shr);                     ASSERT_success(event);
+}
+
+#else
+
+static void test()
+{
+}
+
+#endif
+
+void test_task_shared_2()
+{
+	TEST_Notify();
+	TEST_Call();
+}
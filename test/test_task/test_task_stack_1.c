@@ -0,0 +1,42 @@
+#include "test.h"
+
+#if OS_STACK_SCAN
+
+static void proc()
+{
+	        tsk_sleep();
+}
+
+static void test()
+{
+	unsigned used;
+	unsigned free;
+	unsigned event;
+
+	        tsk_startFrom(tsk2, proc);
+	        tmr_startFrom(tmr1, 1, 0, NULL);
+	event = tmr_wait(tmr1);                      ASSERT_success(event);
+	used  = tsk_stackUsed(tsk2);                 ASSERT(used >= sizeof(ctx_t));
+	                                             ASSERT(used < tsk2->size);
+	free  = (tsk2->size - used) / sizeof(stk_t);
+	        tsk2->stack[free / 2] = 0;           // the blocked task has used half of its free stack space
+	        tmr_startFrom(tmr1, 1, 0, NULL);
+	event = tmr_wait(tmr1);                      ASSERT_success(event);
+	used  = tsk_stackUsed(tsk2);                 ASSERT(used == tsk2->size - free / 2 * sizeof(stk_t));
+	event = tsk_reset(tsk2);                     ASSERT_success(event);
+	used  = tsk_stackUsed(&MAIN);                ASSERT(used == 0);
+}
+
+#else
+
+static void test()
+{
+}
+
+#endif
+
+void test_task_stack_1()
+{
+	TEST_Notify();
+	TEST_Call();
+}
@@ -0,0 +1,52 @@
+#include "test.h"
+
+#if OS_TASK_STATS
+
+static void proc()
+{
+	        tsk_yield();
+	        tsk_stop();
+}
+
+static void test()
+{
+	sst_t    sys1, sys2;
+	tst_t    st1, st2;
+	tst_t    cur1, cur2;
+	unsigned event;
+
+	        sys_stats(&sys1);
+	        tsk_stats(tsk2, &st1);
+	        tsk_stats(tsk_this(), &cur1);
+	        tsk_startFrom(tsk2, proc);
+	event = tsk_join(tsk2);                      ASSERT_success(event);
+	        tmr_startFrom(tmr1, 1, 0, NULL);
+	event = tmr_wait(tmr1);                      ASSERT_success(event);
+	        sys_stats(&sys2);
+	        tsk_stats(tsk2, &st2);
+	        tsk_stats(tsk_this(), &cur2);
+	                                             ASSERT(sys2.switches - sys1.switches >= 2);
+	                                             ASSERT(sys2.wakeups  - sys1.wakeups  >= 1);
+	                                             ASSERT(sys2.timers   - sys1.timers   >= 1);
+	                                             ASSERT(sys2.idle     >= sys1.idle);
+	                                             ASSERT(st2.switches  - st1.switches  >= 1);
+	                                             ASSERT(st2.time      >= st1.time);
+	                                             ASSERT(st2.max       >= st1.max);
+	                                             ASSERT(cur2.switches - cur1.switches >= 2);
+	                                             ASSERT(cur2.preempts - cur1.preempts >= 1);
+	                                             ASSERT(cur2.time     >= cur1.time);
+}
+
+#else
+
+static void test()
+{
+}
+
+#endif
+
+void test_task_stats_1()
+{
+	TEST_Notify();
+	TEST_Call();
+}
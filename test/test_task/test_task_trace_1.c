@@ -0,0 +1,67 @@
+#include "test.h"
+
+#if OS_TRACE_SIZE
+
+#define SIZE 32
+
+static stm_t stm = STM_INIT(SIZE * sizeof(trc_t));
+static trc_t rec[SIZE];
+
+static void proc()
+{
+	        sem_give(sem1);
+	        tsk_stop();
+}
+
+static unsigned find( unsigned cnt, unsigned id, const void *obj )
+{
+	unsigned i;
+
+	for (i = 0; i < cnt; i++)
+		if (rec[i].id == id && rec[i].obj == obj)
+			return i;
+
+	return cnt;
+}
+
+static void test()
+{
+	trh_t    hdr;
+	unsigned event;
+	unsigned cnt;
+	unsigned i;
+
+	        trc_header(&hdr);                    ASSERT(hdr.magic == TRC_MAGIC);
+	                                             ASSERT(hdr.rec_size == sizeof(trc_t));
+	                                             ASSERT(hdr.main == (uintptr_t)&MAIN);
+	while  (trc_read(rec, SIZE) > 0) {}
+	        tsk_startFrom(tsk2, proc);
+	event = tsk_join(tsk2);                      ASSERT_success(event);
+	event = sem_take(sem1);                      ASSERT_success(event);
+	cnt   = trc_read(rec, SIZE);                 ASSERT(cnt > 0 && cnt < SIZE);
+	                                             ASSERT(find(cnt, TRC_SWITCH, tsk2)  < cnt);
+	                                             ASSERT(find(cnt, TRC_SWITCH, &MAIN) < cnt);
+	                                             ASSERT(find(cnt, TRC_GIVE,   sem1)  < find(cnt, TRC_TAKE, sem1));
+	                                             ASSERT(find(cnt, TRC_TAKE,   sem1)  < cnt);
+	for (i = 1; i < cnt; i++)                    ASSERT((cyc_t)(rec[i].time - rec[0].time) >= (cyc_t)(rec[i - 1].time - rec[0].time));
+	        tsk_startFrom(tsk2, proc);
+	event = tsk_join(tsk2);                      ASSERT_success(event);
+	event = sem_take(sem1);                      ASSERT_success(event);
+	cnt   = trc_drain(&stm);                     ASSERT(cnt > 0 && stm_count(&stm) == cnt * sizeof(trc_t));
+	cnt   = trc_read(rec, SIZE);                 ASSERT(find(cnt, TRC_GIVE, &stm) == cnt); // draining is not traced
+	        stm_reset(&stm);
+}
+
+#else
+
+static void test()
+{
+}
+
+#endif
+
+void test_task_trace_1()
+{
+	TEST_Notify();
+	TEST_Call();
+}
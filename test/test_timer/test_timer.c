@@ -4,6 +4,9 @@ void test_timer()
 {
 	UNIT_Notify();
 	TEST_Add(test_timer_1);
+	TEST_Add(test_timer_4);
+	TEST_Add(test_timer_5);
+	TEST_Add(test_timer_6);
 #ifndef __CSMC__
 	TEST_Add(test_timer_2);
 	TEST_Add(test_timer_3);
@@ -0,0 +1,41 @@
+#include "test.h"
+
+#define SIZE 8
+
+static tmr_t    Tmr[SIZE];
+static unsigned order[SIZE];
+static unsigned counter;
+
+static void proc()
+{
+	unsigned i = (unsigned)(tmr_thisISR() - Tmr);
+
+	                                             ASSERT(i < SIZE);
+	        order[counter++] = i;
+}
+
+static void test()
+{
+	unsigned event;
+	unsigned i;
+
+	        counter = 0;
+	        sys_lock();
+	        {
+		        for (i = SIZE; i-- > 0; )
+			        tmr_startFrom(&Tmr[i], (i + 1) * MSEC, 0, proc);
+		        tmr_reset(&Tmr[1]);
+		        tmr_reset(&Tmr[5]);
+	        }
+	        sys_unlock();
+	event = tmr_wait(&Tmr[SIZE - 1]);            ASSERT_success(event);
+	                                             ASSERT(counter == SIZE - 2);
+	for (i = 1; i < counter; i++)
+	                                             ASSERT(order[i - 1] < order[i]);
+}
+
+void test_timer_4()
+{
+	TEST_Notify();
+	TEST_Call();
+}
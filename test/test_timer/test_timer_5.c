@@ -0,0 +1,37 @@
+#include "test.h"
+
+static tmr_t    Tmr = _TMR_INIT_DMN(0);
+static unsigned counter;
+
+static void proc()
+{
+#if OS_TIMER_DAEMON
+	                                             ASSERT(port_isr_context() == false);
+#endif
+	                                             ASSERT(tmr_thisISR() == &Tmr);
+	        counter++;
+}
+
+static void test()
+{
+	unsigned event;
+	unsigned i;
+
+	        counter = 0;
+	for (i = 1; i <= 3; i++)
+	{
+	        tmr_startFrom(&Tmr, MSEC, 0, proc);
+	event = tmr_wait(&Tmr);                      ASSERT_success(event);
+	                                             ASSERT(counter == i);
+	}
+	        tmr_reset(&Tmr);
+#if OS_TIMER_DAEMON
+	                                             ASSERT(Tmr.dmn.back == NULL);
+#endif
+}
+
+void test_timer_5()
+{
+	TEST_Notify();
+	TEST_Call();
+}
@@ -0,0 +1,52 @@
+#include "test.h"
+
+#if OS_TIMER_DAEMON
+
+static tmr_t    Tmr6;
+static unsigned counter;
+
+static void proc()
+{
+	if (++counter == 1)
+	{
+	        tmr_start(&Tmr6, MSEC, 0);
+	        tsk_sleepFor(2*MSEC);
+	}
+}
+
+static void kill()
+{
+	        counter++;
+	        tmr_delete(tmr_thisISR());
+}
+
+static void test()
+{
+	tmr_t  * tmr;
+
+	        counter = 0;
+	        tmr_setMode(&Tmr6, tmrDaemon);
+	        tmr_startFrom(&Tmr6, MSEC, 0, proc);
+	        tsk_sleepFor(4*MSEC);                ASSERT(counter == 2);
+	                                             ASSERT(Tmr6.dmn.back == NULL);
+	        tmr_setMode(&Tmr6, tmrISR);
+
+	tmr   = tmr_create(kill);                    ASSERT(tmr);
+	        tmr_setMode(tmr, tmrDaemon);
+	        tmr_start(tmr, MSEC, 0);
+	        tsk_sleepFor(2*MSEC);                ASSERT(counter == 3);
+}
+
+#else
+
+static void test()
+{
+}
+
+#endif
+
+void test_timer_6()
+{
+	TEST_Notify();
+	TEST_Call();
+}
@@ -0,0 +1,180 @@
+#!/usr/bin/env python3
+
+# StateOS: trace2json.py
+# converts the binary dump of the StateOS kernel trace (OS_TRACE_SIZE > 0)
+# into the Chrome / Perfetto trace-event JSON format
+#
+# the dump consists of the trace header (trh_t) followed by the trace records (trc_t),
+# both in the byte order of the target
+#
+# usage: trace2json.py [-b little|big] [-n name=address ...] dump.bin [trace.json]
+#
+# every task is shown as a thread with its running, ready and blocked intervals,
+# task priorities are shown as counters (priority inheritance becomes visible),
+# take / give requests and timer events are shown as instant events
+
+import argparse
+import json
+import struct
+import sys
+
+TRC_MAGIC   = 0x43525453
+TRC_VERSION = 1
+
+TRC_SWITCH  = 1
+TRC_WAKEUP  = 2
+TRC_WAIT    = 3
+TRC_PRIO    = 4
+TRC_TICK    = 5
+TRC_TIMER   = 6
+TRC_TAKE    = 7
+TRC_GIVE    = 8
+
+EVENTS = {
+	0x00000000: 'E_SUCCESS',
+	0xFFFFFFFF: 'E_FAILURE',
+	0xFFFFFFFE: 'E_STOPPED',
+	0xFFFFFFFD: 'E_DELETED',
+	0xFFFFFFFC: 'E_TIMEOUT',
+	0x00000001: 'OWNERDEAD',
+}
+
+HEADER = 'IHBBIIIIQQ'
+UNSIGNED = { 2: 'H', 4: 'I', 8: 'Q' }
+
+def align( offset, size ):
+	return (offset + size - 1) // size * size
+
+class Decoder:
+
+	def __init__( self, data, order, names ):
+		self.order = order
+		size = struct.calcsize(order + HEADER)
+		(self.magic, self.version, self.time_size, self.ptr_size, self.rec_size,
+		 self.frequency, self.size, self.lost, self.main, self.idle) = struct.unpack_from(order + HEADER, data, 0)
+		if self.magic != TRC_MAGIC:
+			raise ValueError('invalid trace header (wrong magic number or byte order)')
+		if self.version != TRC_VERSION:
+			raise ValueError('unsupported trace version %d' % self.version)
+		self.data = data[size:]
+		self.names = { self.main: 'main', self.idle: 'idle' }
+		self.names.update(names)
+		# layout of the trace record: time, obj, arg, id, prio (natural alignment)
+		obj = align(self.time_size, self.ptr_size)
+		arg = obj + self.ptr_size
+		ids = arg + self.ptr_size
+		self.layout = [(0, UNSIGNED[self.time_size]), (obj, UNSIGNED[self.ptr_size]), (arg, UNSIGNED[self.ptr_size]), (ids, 'I'), (ids + 4, 'I')]
+		self.events = []
+		self.tids = { None: 0 } # interrupts
+
+	def records( self ):
+		high = 0
+		last = None
+		base = None
+		mask = (1 << (8 * self.time_size)) - 1
+		for pos in range(0, len(self.data) - self.rec_size + 1, self.rec_size):
+			time, obj, arg, ident, prio = (struct.unpack_from(self.order + f, self.data, pos + o)[0] for o, f in self.layout)
+			# unwrap the cycle counter, the trace starts at 0 us
+			if last is not None and time < last:
+				high += mask + 1
+			last = time
+			if base is None:
+				base = time
+			yield (high + time - base) * 1e6 / self.frequency, ident, obj, arg, prio
+
+	def name( self, addr ):
+		return self.names.get(addr, '0x%x' % addr)
+
+	def tid( self, tsk ):
+		if tsk not in self.tids:
+			self.tids[tsk] = len(self.tids)
+			self.events.append({ 'ph': 'M', 'pid': 1, 'tid': self.tids[tsk], 'name': 'thread_name', 'args': { 'name': self.name(tsk) } })
+		return self.tids[tsk]
+
+	def span( self, tsk, name, begin, end, args = None ):
+		if begin is not None and end > begin:
+			event = { 'ph': 'X', 'pid': 1, 'tid': self.tid(tsk), 'name': name, 'ts': begin, 'dur': end - begin }
+			if args:
+				event['args'] = args
+			self.events.append(event)
+
+	def instant( self, tsk, name, ts, args = None ):
+		event = { 'ph': 'i', 's': 't', 'pid': 1, 'tid': self.tid(tsk), 'name': name, 'ts': ts }
+		if args:
+			event['args'] = args
+		self.events.append(event)
+
+	def counter( self, tsk, prio, ts ):
+		self.events.append({ 'ph': 'C', 'pid': 1, 'name': 'prio ' + self.name(tsk), 'ts': ts, 'args': { 'prio': prio } })
+
+	def decode( self ):
+		self.events.append({ 'ph': 'M', 'pid': 1, 'name': 'process_name', 'args': { 'name': 'StateOS' } })
+		self.events.append({ 'ph': 'M', 'pid': 1, 'tid': 0, 'name': 'thread_name', 'args': { 'name': 'interrupts' } })
+		cur     = None # current task
+		running = {}   # task => start of the running interval
+		ready   = {}   # task => time of the wakeup (start of the ready interval)
+		blocked = {}   # task => (time, object) of the wait
+		prios   = {}   # task => priority
+		ts      = 0
+		for ts, ident, obj, arg, prio in self.records():
+			if ident == TRC_SWITCH:
+				prev = arg
+				self.span(prev, 'running', running.pop(prev, None), ts)
+				wake = ready.pop(obj, None)
+				self.span(obj, 'ready', wake, ts, { 'wake latency (us)': ts - wake if wake is not None else 0 })
+				running[obj] = ts
+				cur = obj
+				if prios.get(obj) != prio:
+					prios[obj] = prio
+					self.counter(obj, prio, ts)
+			elif ident == TRC_WAKEUP:
+				wait = blocked.pop(obj, None)
+				if wait:
+					self.span(obj, 'blocked on ' + self.name(wait[1]), wait[0], ts, { 'event': EVENTS.get(arg & 0xFFFFFFFF, arg) })
+				ready[obj] = ts
+			elif ident == TRC_WAIT:
+				blocked[obj] = (ts, arg)
+			elif ident == TRC_PRIO:
+				prios[obj] = prio
+				self.counter(obj, prio, ts)
+			elif ident == TRC_TICK:
+				self.instant(None, 'tick', ts)
+			elif ident == TRC_TIMER:
+				self.instant(None, 'timer ' + self.name(obj), ts)
+			elif ident in (TRC_TAKE, TRC_GIVE):
+				self.instant(cur, ('take ' if ident == TRC_TAKE else 'give ') + self.name(obj), ts)
+		# close the intervals at the end of the trace
+		for tsk, begin in running.items():
+			self.span(tsk, 'running', begin, ts)
+		for tsk, (begin, wait) in blocked.items():
+			self.span(tsk, 'blocked on ' + self.name(wait), begin, ts)
+		return { 'traceEvents': self.events, 'displayTimeUnit': 'ns',
+		         'otherData': { 'frequency': self.frequency, 'buffer size': self.size, 'lost records': self.lost } }
+
+def main():
+	parser = argparse.ArgumentParser(description = 'convert StateOS kernel trace dump to Chrome / Perfetto trace-event JSON')
+	parser.add_argument('dump', help = 'binary trace dump (trace header followed by trace records)')
+	parser.add_argument('json', nargs = '?', help = 'output file (default: standard output)')
+	parser.add_argument('-b', '--byteorder', choices = ['little', 'big'], default = 'little', help = 'byte order of the target (default: little)')
+	parser.add_argument('-n', '--name', action = 'append', default = [], metavar = 'NAME=ADDRESS', help = 'name of the object at the given address')
+	args = parser.parse_args()
+
+	names = {}
+	for item in args.name:
+		name, addr = item.split('=', 1)
+		names[int(addr, 0)] = name
+
+	with open(args.dump, 'rb') as f:
+		data = f.read()
+
+	decoder = Decoder(data, '<' if args.byteorder == 'little' else '>', names)
+	trace = decoder.decode()
+
+	if args.json:
+		with open(args.json, 'w') as f:
+			json.dump(trace, f, indent = 1)
+	else:
+		json.dump(trace, sys.stdout, indent = 1)
+
+if __name__ == '__main__':
+	main()